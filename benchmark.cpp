@@ -0,0 +1,723 @@
+#include "vector.h"
+#include "benchmark.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Benchmark executable comparing Vector with std::vector and std::deque.
+//
+// Build and run:
+//     g++ -std=c++17 -O2 -DNDEBUG -pthread benchmark.cpp -o benchmark
+//     ./benchmark [--suite=ops|realloc|memory|threads] [--max-count=N] [--max-quadratic-count=N] [--min-time-ms=N] [--perf=0|1]
+//         > bench_output.txt
+//
+// Results are written to stdout as a JSON array. Unless `--perf=0` is given, every record also carries
+// `<event>_per_op` hardware counter fields (cycles, instructions, L1D/LLC/dTLB misses, branch misses)
+// for the events the kernel lets the process open; check `perf_event_paranoid` if they are missing.
+
+namespace {
+
+using namespace bench;
+
+// ------- Container adapters -------
+// A uniform interface over the benchmarked containers.
+
+template <typename C>
+struct Adapter;
+
+template <typename T>
+struct Adapter<Vector<T>> {
+    static constexpr std::string_view NAME = "Vector";
+    static constexpr bool HAS_RESERVE = true;
+
+    static void PushBack(Vector<T>& c, const T& value) {
+        c.PushBack(value);
+    }
+    static void EmplaceBack(Vector<T>& c, size_t seed) {
+        c.EmplaceBack(seed);
+    }
+    static void Reserve(Vector<T>& c, size_t n) {
+        c.Reserve(n);
+    }
+    static void Insert(Vector<T>& c, size_t index, const T& value) {
+        c.Insert(c.cbegin() + index, value);
+    }
+    static void Erase(Vector<T>& c, size_t index) {
+        c.Erase(c.cbegin() + index);
+    }
+};
+
+template <typename T>
+struct Adapter<std::vector<T>> {
+    static constexpr std::string_view NAME = "std::vector";
+    static constexpr bool HAS_RESERVE = true;
+
+    static void PushBack(std::vector<T>& c, const T& value) {
+        c.push_back(value);
+    }
+    static void EmplaceBack(std::vector<T>& c, size_t seed) {
+        c.emplace_back(seed);
+    }
+    static void Reserve(std::vector<T>& c, size_t n) {
+        c.reserve(n);
+    }
+    static void Insert(std::vector<T>& c, size_t index, const T& value) {
+        c.insert(c.cbegin() + index, value);
+    }
+    static void Erase(std::vector<T>& c, size_t index) {
+        c.erase(c.cbegin() + index);
+    }
+};
+
+template <typename T>
+struct Adapter<std::deque<T>> {
+    static constexpr std::string_view NAME = "std::deque";
+    static constexpr bool HAS_RESERVE = false;
+
+    static void PushBack(std::deque<T>& c, const T& value) {
+        c.push_back(value);
+    }
+    static void EmplaceBack(std::deque<T>& c, size_t seed) {
+        c.emplace_back(seed);
+    }
+    static void Reserve(std::deque<T>& /*c*/, size_t /*n*/) {
+    }
+    static void Insert(std::deque<T>& c, size_t index, const T& value) {
+        c.insert(c.cbegin() + index, value);
+    }
+    static void Erase(std::deque<T>& c, size_t index) {
+        c.erase(c.cbegin() + index);
+    }
+};
+
+template <typename C>
+void Fill(C& c, size_t n) {
+    using T = std::decay_t<decltype(*c.begin())>;
+    for (size_t i = 0; i < n; ++i) {
+        Adapter<C>::PushBack(c, T(i));
+    }
+}
+
+// Where an insertion or erasure at step `i` happens in a container of `size` elements.
+enum class Position {
+    Front,
+    Middle,
+    Back
+};
+
+size_t IndexFor(Position position, size_t size) {
+    switch (position) {
+    case Position::Front: return 0;
+    case Position::Middle: return size / 2;
+    case Position::Back: return size;
+    }
+    return size;
+}
+
+// ------- Operations suite -------
+
+template <typename C>
+void RunOperations(const Options& options, size_t count, std::vector<Result>& results) {
+    using A = Adapter<C>;
+    using T = std::decay_t<decltype(*std::declval<C&>().begin())>;
+    const T value(42);
+
+    auto record = [&](std::string_view operation, size_t op_count, Result result) {
+        result.suite = "ops";
+        result.container = std::string(A::NAME);
+        result.operation = std::string(operation);
+        result.element_bytes = sizeof(T);
+        result.count = op_count;
+        result.bytes_per_sec = result.ops_per_sec * sizeof(T);
+        results.push_back(std::move(result));
+    };
+
+    std::optional<C> c;
+    auto make_empty = [&] {
+        c.reset();
+        c.emplace();
+    };
+    auto make_filled = [&] {
+        make_empty();
+        Fill(*c, count);
+    };
+
+    record("push_back", count, Measure(options, count, make_empty, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            A::PushBack(*c, value);
+        }
+        DoNotOptimize(*c);
+    }));
+
+    record("emplace_back", count, Measure(options, count, make_empty, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            A::EmplaceBack(*c, i);
+        }
+        DoNotOptimize(*c);
+    }));
+
+    if constexpr (A::HAS_RESERVE) {
+        // Growing a full container relocates every element once
+        record("reserve", count, Measure(options, count, make_filled, [&] {
+            A::Reserve(*c, count * 2);
+            DoNotOptimize(*c);
+        }));
+    }
+
+    const std::pair<std::string_view, Position> positions[] = {
+        {"front", Position::Front}, {"middle", Position::Middle}, {"back", Position::Back}};
+    for (const auto& [name, position] : positions) {
+        if (position != Position::Back && count > options.max_quadratic_count) {
+            continue;
+        }
+        record("insert_" + std::string(name), count, Measure(options, count, make_empty, [&, position = position] {
+            for (size_t i = 0; i < count; ++i) {
+                A::Insert(*c, IndexFor(position, i), value);
+            }
+            DoNotOptimize(*c);
+        }));
+        record("erase_" + std::string(name), count, Measure(options, count, make_filled, [&, position = position] {
+            for (size_t i = count; i > 0; --i) {
+                A::Erase(*c, std::min(IndexFor(position, i), i - 1));
+            }
+            DoNotOptimize(*c);
+        }));
+    }
+
+    {
+        C source;
+        Fill(source, count);
+        std::optional<C> copy;
+        record("copy", count, Measure(options, count, [&] { copy.reset(); }, [&] {
+            copy.emplace(source);
+            DoNotOptimize(*copy);
+        }));
+
+        // Moving back and forth needs no refill between repetitions
+        record("move", 2, Measure(options, 2, [] {}, [&] {
+            C moved(std::move(source));
+            source = std::move(moved);
+            DoNotOptimize(source);
+        }));
+    }
+}
+
+template <typename T>
+void RunOperationsForElement(const Options& options, std::vector<Result>& results) {
+    for (size_t count = 10; count <= options.max_count; count *= 10) {
+        RunOperations<Vector<T>>(options, count, results);
+        RunOperations<std::vector<T>>(options, count, results);
+        RunOperations<std::deque<T>>(options, count, results);
+    }
+}
+
+void RunOperationsSuite(const Options& options, std::vector<Result>& results) {
+    RunOperationsForElement<Payload<4>>(options, results);
+    RunOperationsForElement<Payload<16>>(options, results);
+    RunOperationsForElement<Payload<64>>(options, results);
+    RunOperationsForElement<Payload<256>>(options, results);
+}
+
+// ------- Reallocation matrix suite -------
+// Grows Vector<T, VectorStats> for element types with different move/copy traits and reports which
+// relocation branch of Vector ran, so that silent copy fallbacks show up next to their cost.
+
+// Non-trivial, but moving is noexcept: reallocation moves.
+struct NothrowMovable {
+    explicit NothrowMovable(size_t seed) noexcept : payload(seed) {
+    }
+    NothrowMovable(const NothrowMovable& other) noexcept : payload(other.payload) {
+    }
+    NothrowMovable(NothrowMovable&& other) noexcept : payload(other.payload) {
+    }
+    Payload<64> payload;
+};
+
+// Declares a copy constructor only, so there is no move constructor to use: reallocation copies.
+struct CopyOnly {
+    explicit CopyOnly(size_t seed) noexcept : payload(seed) {
+    }
+    CopyOnly(const CopyOnly& other) : payload(other.payload) {
+    }
+    Payload<64> payload;
+};
+
+// Like test.cpp's Obj with `throw_on_copy`, but with a move constructor that is not noexcept:
+// for the strong exception guarantee reallocation has to copy.
+struct ThrowingMove {
+    explicit ThrowingMove(size_t seed) noexcept : payload(seed) {
+    }
+    ThrowingMove(const ThrowingMove& other) : payload(other.payload) {
+        if (other.throw_on_copy) {
+            throw std::runtime_error("Oops");
+        }
+    }
+    ThrowingMove(ThrowingMove&& other) : payload(other.payload) {
+    }
+    Payload<64> payload;
+    bool throw_on_copy = false;
+};
+
+// Move-only with a throwing move constructor: there is nothing to copy, so reallocation moves.
+struct ThrowingMoveOnly {
+    explicit ThrowingMoveOnly(size_t seed) noexcept : payload(seed) {
+    }
+    ThrowingMoveOnly(const ThrowingMoveOnly&) = delete;
+    ThrowingMoveOnly(ThrowingMoveOnly&& other) : payload(other.payload) {
+    }
+    Payload<64> payload;
+};
+
+template <typename T>
+void RunReallocation(const Options& options, std::string_view type_name, size_t count, std::vector<Result>& results) {
+    using V = Vector<T, VectorStats>;
+    std::optional<V> v;
+    VectorStats stats;
+
+    auto record = [&](std::string_view operation, Result result) {
+        const size_t relocated = stats.elements_moved + stats.elements_copied;
+        result.suite = "realloc";
+        result.container = std::string(type_name);
+        result.operation = std::string(operation);
+        result.element_bytes = sizeof(T);
+        result.count = count;
+        result.bytes_per_sec = result.ops_per_sec * sizeof(T);
+        result.extra.insert(result.extra.end(), {
+            {"growths", static_cast<double>(stats.growths)},
+            {"elements_moved", static_cast<double>(stats.elements_moved)},
+            {"elements_copied", static_cast<double>(stats.elements_copied)},
+            {"bytes_relocated", static_cast<double>(relocated * sizeof(T))},
+            {"ns_per_growth", stats.growths ? result.ns_per_op * count / stats.growths : 0},
+        });
+        result.labels = {
+            {"branch", stats.elements_copied ? "copy" : stats.elements_moved ? "move" : "none"},
+            {"trivially_copyable", std::is_trivially_copyable_v<T> ? "yes" : "no"},
+            {"nothrow_move", std::is_nothrow_move_constructible_v<T> ? "yes" : "no"},
+        };
+        results.push_back(std::move(result));
+    };
+
+    // Grow from empty by doubling: log2(count) reallocations relocating ~count elements in total
+    Result grow = Measure(options, count, [&] { v.reset(); v.emplace(); }, [&] {
+        for (size_t i = 0; i < count; ++i) {
+            v->EmplaceBack(i);
+        }
+        DoNotOptimize(*v);
+    });
+    stats = v->GetStats();
+    record("emplace_back_growth", std::move(grow));
+
+    // A single reallocation of a full vector
+    VectorStats before;
+    Result reserve = Measure(options, count, [&] {
+        v.reset();
+        v.emplace();
+        v->Reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            v->EmplaceBack(i);
+        }
+        before = v->GetStats();
+    }, [&] {
+        v->Reserve(count * 2);
+        DoNotOptimize(*v);
+    });
+    stats = v->GetStats();
+    stats.growths -= before.growths;
+    stats.elements_moved -= before.elements_moved;
+    stats.elements_copied -= before.elements_copied;
+    record("reserve", std::move(reserve));
+}
+
+void RunReallocationSuite(const Options& options, std::vector<Result>& results) {
+    for (size_t count = 10; count <= options.max_count; count *= 10) {
+        RunReallocation<Payload<64>>(options, "trivially_copyable", count, results);
+        RunReallocation<NothrowMovable>(options, "nothrow_movable", count, results);
+        RunReallocation<CopyOnly>(options, "copy_only", count, results);
+        RunReallocation<ThrowingMove>(options, "throwing_move", count, results);
+        RunReallocation<ThrowingMoveOnly>(options, "throwing_move_only", count, results);
+    }
+}
+
+// ------- Memory footprint suite -------
+// Runs allocation-heavy workloads once and reports what they cost in memory rather than time:
+// the peak RSS growth, the bytes requested from RawMemory, the unused capacity left behind and
+// the number of buffers alive at the end and at most.
+
+// Stats policy summing the buffers of every vector that uses it.
+struct MemoryStats {
+    void OnAllocate(size_t /*capacity*/, size_t bytes) noexcept {
+        bytes_requested += bytes;
+        ++allocations;
+        ++live_buffers;
+        peak_live_buffers = std::max(peak_live_buffers, live_buffers);
+    }
+    void OnDeallocate() noexcept {
+        --live_buffers;
+    }
+    void OnGrow() noexcept {
+    }
+    void OnRelocate(size_t /*moved*/, size_t /*copied*/) noexcept {
+    }
+
+    static void Reset() {
+        bytes_requested = 0;
+        allocations = 0;
+        peak_live_buffers = live_buffers;
+    }
+
+    static inline size_t bytes_requested = 0;
+    static inline size_t allocations = 0;
+    static inline size_t live_buffers = 0;
+    static inline size_t peak_live_buffers = 0;
+};
+
+// Read a `<key>: <n> kB` line of /proc/self/status in bytes, or 0 if it is not available.
+size_t ReadProcStatusBytes(std::string_view key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.size() > key.size() && line.compare(0, key.size(), key) == 0 && line[key.size()] == ':') {
+            return std::stoull(line.substr(key.size() + 1)) * 1024;
+        }
+    }
+    return 0;
+}
+
+// Reset the peak RSS of the process to its current RSS.
+// @returns false if the kernel does not support it, so the peak covers the whole process lifetime.
+bool ResetPeakRss() {
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    clear_refs << "5";
+    clear_refs.flush();
+    return static_cast<bool>(clear_refs);
+}
+
+template <typename T>
+struct IsVector : std::false_type {};
+template <typename T, typename S>
+struct IsVector<Vector<T, S>> : std::true_type {};
+
+// Sum the unused capacity of `v` and, for nested vectors, of every inner vector, in bytes.
+template <typename T, typename S>
+size_t WastedBytes(const Vector<T, S>& v) {
+    size_t wasted = (v.Capacity() - v.Size()) * sizeof(T);
+    if constexpr (IsVector<T>::value) {
+        for (const T& inner : v) {
+            wasted += WastedBytes(inner);
+        }
+    }
+    return wasted;
+}
+
+template <typename T>
+void RunMemoryWorkloads(size_t count, std::vector<Result>& results) {
+    using V = Vector<T, MemoryStats>;
+    const size_t INNER_SIZE = 16;
+
+    auto run = [&](std::string_view workload, auto&& body) {
+        const bool scoped_peak = ResetPeakRss();
+        const size_t rss_before = ReadProcStatusBytes("VmRSS");
+        MemoryStats::Reset();
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto [wasted, live_buffers] = body();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        const size_t peak_rss = ReadProcStatusBytes("VmHWM");
+
+        Result result;
+        result.suite = "memory";
+        result.container = "Vector";
+        result.operation = std::string(workload);
+        result.element_bytes = sizeof(T);
+        result.count = count;
+        result.repetitions = 1;
+        result.ns_per_op = ns / static_cast<double>(count);
+        result.ops_per_sec = ns > 0 ? static_cast<double>(count) * 1e9 / ns : 0;
+        result.bytes_per_sec = result.ops_per_sec * sizeof(T);
+        result.extra = {
+            {"peak_rss_growth_bytes", static_cast<double>(peak_rss > rss_before ? peak_rss - rss_before : 0)},
+            {"bytes_requested", static_cast<double>(MemoryStats::bytes_requested)},
+            {"payload_bytes", static_cast<double>(count * sizeof(T))},
+            {"wasted_capacity_bytes", static_cast<double>(wasted)},
+            {"allocations", static_cast<double>(MemoryStats::allocations)},
+            {"live_buffers", static_cast<double>(live_buffers)},
+            {"peak_live_buffers", static_cast<double>(MemoryStats::peak_live_buffers)},
+        };
+        result.labels = {{"peak_rss_scope", scoped_peak ? "workload" : "process"}};
+        results.push_back(std::move(result));
+    };
+
+    // The wasted capacity and live buffers are taken at the end of the workload, while its vectors are alive
+    auto snapshot = [](const auto& v) {
+        return std::make_pair(WastedBytes(v), MemoryStats::live_buffers);
+    };
+
+    run("append_only", [&] {
+        V v;
+        for (size_t i = 0; i < count; ++i) {
+            v.EmplaceBack(i);
+        }
+        return snapshot(v);
+    });
+
+    run("grow_then_drain", [&] {
+        V v;
+        for (size_t i = 0; i < count; ++i) {
+            v.EmplaceBack(i);
+        }
+        while (v.Size() > 0) {
+            v.PopBack();
+        }
+        return snapshot(v);
+    });
+
+    run("nested", [&] {
+        Vector<V, MemoryStats> outer;
+        for (size_t i = 0; i < count; i += INNER_SIZE) {
+            V& inner = outer.EmplaceBack();
+            for (size_t j = i; j < std::min(i + INNER_SIZE, count); ++j) {
+                inner.EmplaceBack(j);
+            }
+        }
+        return snapshot(outer);
+    });
+}
+
+void RunMemorySuite(const Options& options, std::vector<Result>& results) {
+    for (size_t count = 10; count <= options.max_count; count *= 10) {
+        RunMemoryWorkloads<Payload<4>>(count, results);
+        RunMemoryWorkloads<Payload<64>>(count, results);
+    }
+}
+
+// ------- Thread contention suite -------
+// Splits `count` PushBack calls over 1 to all hardware threads, once into thread-local vectors merged
+// at the end and once into one mutex-guarded shared vector, plus a churn of short-lived vectors that
+// only stresses the allocator. The scaling efficiency against one thread, the contended lock
+// acquisitions and the allocation rate are the baseline for concurrent containers and pooled allocators.
+
+// Stats policy counting the allocations of all threads.
+struct ConcurrentStats {
+    void OnAllocate(size_t /*capacity*/, size_t bytes) noexcept {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes_requested.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    void OnDeallocate() noexcept {
+    }
+    void OnGrow() noexcept {
+    }
+    void OnRelocate(size_t /*moved*/, size_t /*copied*/) noexcept {
+    }
+
+    static void Reset() {
+        allocations = 0;
+        bytes_requested = 0;
+    }
+
+    static inline std::atomic<size_t> allocations{0};
+    static inline std::atomic<size_t> bytes_requested{0};
+};
+
+// Get the thread counts to run: powers of two up to the hardware concurrency, and the hardware concurrency itself.
+std::vector<size_t> ThreadCounts() {
+    const size_t max_threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    std::vector<size_t> counts;
+    for (size_t threads = 1; threads < max_threads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(max_threads);
+    return counts;
+}
+
+// Runs `work(thread_index, first, last)` on `threads` threads, each taking an equal share of [0, count).
+template <typename Work>
+void RunOnThreads(size_t threads, size_t count, Work&& work) {
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (size_t t = 0; t < threads; ++t) {
+        pool.emplace_back(work, t, count * t / threads, count * (t + 1) / threads);
+    }
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+}
+
+template <typename T>
+void RunThreadWorkloads(const Options& options, size_t threads, size_t count, std::vector<Result>& results,
+                        std::vector<std::pair<std::string, double>>& single_thread_ops) {
+    using V = Vector<T, ConcurrentStats>;
+    const size_t CHURN_SIZE = 16;
+
+    auto run = [&](std::string_view workload, std::atomic<size_t>* contended, auto&& body) {
+        ConcurrentStats::Reset();
+        if (contended) {
+            *contended = 0;
+        }
+        Result result = Measure(options, count, [] {}, body);
+        result.suite = "threads";
+        result.container = "Vector";
+        result.operation = std::string(workload);
+        result.element_bytes = sizeof(T);
+        result.count = count;
+        result.bytes_per_sec = result.ops_per_sec * sizeof(T);
+
+        // The first run of a workload is the single-threaded reference for the efficiency of the others
+        const std::string key = std::string(workload) + "/" + std::to_string(sizeof(T));
+        auto it = std::find_if(single_thread_ops.begin(), single_thread_ops.end(), [&](const auto& entry) {
+            return entry.first == key;
+        });
+        if (it == single_thread_ops.end()) {
+            it = single_thread_ops.insert(single_thread_ops.end(), {key, result.ops_per_sec});
+        }
+
+        const double repetitions = static_cast<double>(result.repetitions);
+        result.extra.insert(result.extra.begin(), {
+            {"threads", static_cast<double>(threads)},
+            {"scaling_efficiency", it->second > 0 ? result.ops_per_sec / (it->second * static_cast<double>(threads)) : 0},
+            {"allocations_per_run", static_cast<double>(ConcurrentStats::allocations) / repetitions},
+            {"allocations_per_sec", static_cast<double>(ConcurrentStats::allocations) * 1e9
+                / (result.ns_per_op * static_cast<double>(count) * repetitions)},
+            {"bytes_requested_per_run", static_cast<double>(ConcurrentStats::bytes_requested) / repetitions},
+        });
+        if (contended) {
+            result.extra.emplace_back("contended_locks_per_run", static_cast<double>(*contended) / repetitions);
+        }
+        results.push_back(std::move(result));
+    };
+
+    run("thread_local_merge", nullptr, [&] {
+        std::vector<V> locals(threads);
+        RunOnThreads(threads, count, [&](size_t t, size_t first, size_t last) {
+            // Filled on the worker and moved out once: adjacent headers in `locals` share cache lines
+            V local;
+            for (size_t i = first; i < last; ++i) {
+                local.PushBack(T(i));
+            }
+            locals[t] = std::move(local);
+        });
+        V merged;
+        merged.Reserve(count);
+        for (const V& local : locals) {
+            for (const T& value : local) {
+                merged.PushBack(value);
+            }
+        }
+        DoNotOptimize(merged);
+    });
+
+    std::atomic<size_t> contended{0};
+    run("shared_mutex", &contended, [&] {
+        V shared;
+        std::mutex mutex;
+        RunOnThreads(threads, count, [&](size_t /*t*/, size_t first, size_t last) {
+            size_t local_contended = 0;
+            for (size_t i = first; i < last; ++i) {
+                std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+                if (!lock.owns_lock()) {
+                    ++local_contended;
+                    lock.lock();
+                }
+                shared.PushBack(T(i));
+            }
+            contended.fetch_add(local_contended, std::memory_order_relaxed);
+        });
+        DoNotOptimize(shared);
+    });
+
+    // Nothing is shared but the allocator, so a throughput that does not scale points at it
+    run("allocator_churn", nullptr, [&] {
+        RunOnThreads(threads, count, [&](size_t /*t*/, size_t first, size_t last) {
+            for (size_t i = first; i < last; i += CHURN_SIZE) {
+                V v;
+                for (size_t j = i; j < std::min(i + CHURN_SIZE, last); ++j) {
+                    v.PushBack(T(j));
+                }
+                DoNotOptimize(v);
+            }
+        });
+    });
+}
+
+void RunThreadSuite(Options options, std::vector<Result>& results) {
+    // The counters only see the calling thread, not the workers
+    options.perf_counters = false;
+    std::vector<std::pair<std::string, double>> single_thread_ops;
+    for (const size_t threads : ThreadCounts()) {
+        RunThreadWorkloads<Payload<16>>(options, threads, options.max_count, results, single_thread_ops);
+        RunThreadWorkloads<Payload<64>>(options, threads, options.max_count, results, single_thread_ops);
+    }
+}
+
+// ------- Command line -------
+
+// Parses `--name=value` into `value` if `arg` starts with `--name=`.
+bool ParseFlag(std::string_view arg, std::string_view name, std::string& value) {
+    if (arg.size() > name.size() + 3 && arg.substr(0, 2) == "--" && arg.substr(2, name.size()) == name
+        && arg[name.size() + 2] == '=') {
+        value = std::string(arg.substr(name.size() + 3));
+        return true;
+    }
+    return false;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    std::string suite = "all";
+    for (int i = 1; i < argc; ++i) {
+        std::string value;
+        if (ParseFlag(argv[i], "suite", value)) {
+            if (value != "all" && value != "ops" && value != "realloc" && value != "memory" && value != "threads") {
+                std::cerr << "Unknown argument: " << argv[i] << std::endl;
+                return 1;
+            }
+            suite = value;
+        }
+        else if (ParseFlag(argv[i], "max-count", value)) {
+            options.max_count = std::stoull(value);
+        }
+        else if (ParseFlag(argv[i], "max-quadratic-count", value)) {
+            options.max_quadratic_count = std::stoull(value);
+        }
+        else if (ParseFlag(argv[i], "min-time-ms", value)) {
+            options.min_time_ms = std::stod(value);
+        }
+        else if (ParseFlag(argv[i], "perf", value)) {
+            options.perf_counters = value != "0";
+        }
+        else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    if (options.perf_counters && !PerfCounters::Instance().Available()) {
+        std::cerr << "Hardware performance counters are not available, reporting wall time only" << std::endl;
+    }
+
+    std::vector<Result> results;
+    if (suite == "all" || suite == "ops") {
+        RunOperationsSuite(options, results);
+    }
+    if (suite == "all" || suite == "realloc") {
+        RunReallocationSuite(options, results);
+    }
+    if (suite == "all" || suite == "memory") {
+        RunMemorySuite(options, results);
+    }
+    if (suite == "all" || suite == "threads") {
+        RunThreadSuite(options, results);
+    }
+    WriteJson(std::cout, results);
+}
@@ -0,0 +1,260 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// A tiny harness for the benchmark executable: runs a measured body repeatedly until a minimal
+// wall time is reached, optionally reads hardware performance counters around it, and collects
+// the results as JSON records.
+
+namespace bench {
+
+// Keeps the compiler from optimizing away a value or the writes to the memory it refers to.
+template <typename T>
+inline void DoNotOptimize(T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+// An element of `Bytes` bytes, trivially copyable like most hot-path payloads.
+template <size_t Bytes>
+struct Payload {
+    Payload() = default;
+    explicit Payload(size_t seed) noexcept {
+        std::memset(data, static_cast<int>(seed), Bytes);
+    }
+    unsigned char data[Bytes];
+};
+
+// One measured data point.
+struct Result {
+    std::string suite;
+    std::string container;
+    std::string operation;
+    size_t element_bytes = 0;
+    size_t count = 0;
+    size_t repetitions = 0;
+    double ns_per_op = 0;
+    double ops_per_sec = 0;
+    double bytes_per_sec = 0;
+    // Additional suite-specific numbers and strings, written as extra JSON fields.
+    std::vector<std::pair<std::string, double>> extra;
+    std::vector<std::pair<std::string, std::string>> labels;
+};
+
+// Run settings shared by all suites.
+struct Options {
+    size_t max_count = 1'000'000;
+    // Operations that are quadratic in the element count (inserting at the front, ...) stop here.
+    size_t max_quadratic_count = 10'000;
+    double min_time_ms = 100;
+    // Read hardware performance counters around every measured body, where the kernel allows it.
+    bool perf_counters = true;
+};
+
+// Hardware performance counters of the calling thread, opened through perf_event_open.
+// Every event is opened on its own, so a CPU or kernel lacking one of them (or a sandbox denying
+// them all) only drops those events from the report instead of failing the benchmark.
+class PerfCounters {
+public:
+    PerfCounters() {
+#ifdef __linux__
+        const auto cache_miss = [](uint64_t cache, uint64_t op) {
+            return cache | (op << 8) | (uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16);
+        };
+        const Event events[] = {
+            {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {"l1d_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ)},
+            {"llc_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ)},
+            {"dtlb_misses", PERF_TYPE_HW_CACHE, cache_miss(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ)},
+            {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        };
+        for (const Event& event : events) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = event.type;
+            attr.config = event.config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd >= 0) {
+                names_.push_back(event.name);
+                fds_.push_back(fd);
+            }
+        }
+        totals_.assign(fds_.size(), 0);
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (const int fd : fds_) {
+            close(fd);
+        }
+#endif
+    }
+
+    // Check whether at least one counter could be opened.
+    bool Available() const noexcept {
+        return !fds_.empty();
+    }
+
+    // Zero the accumulated totals.
+    void Reset() {
+        totals_.assign(fds_.size(), 0);
+    }
+
+    // Start counting from zero.
+    void Start() {
+#ifdef __linux__
+        for (const int fd : fds_) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Stop counting and add the counts since Start() to the totals, scaled up for the time an
+    // event was multiplexed out.
+    void Stop() {
+#ifdef __linux__
+        for (const int fd : fds_) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (size_t i = 0; i < fds_.size(); ++i) {
+            uint64_t values[3] = {0, 0, 0};  // value, time enabled, time running
+            if (read(fds_[i], values, sizeof(values)) == static_cast<ssize_t>(sizeof(values)) && values[2] != 0) {
+                totals_[i] += static_cast<double>(values[0]) * static_cast<double>(values[1])
+                    / static_cast<double>(values[2]);
+            }
+        }
+#endif
+    }
+
+    // Append `<event>_per_op` fields for the totals divided by `ops` to `extra`.
+    void Report(double ops, std::vector<std::pair<std::string, double>>& extra) const {
+        for (size_t i = 0; i < fds_.size(); ++i) {
+            extra.emplace_back(names_[i] + "_per_op", ops > 0 ? totals_[i] / ops : 0);
+        }
+    }
+
+    // The counters of the benchmark thread, opened on first use.
+    static PerfCounters& Instance() {
+        static PerfCounters counters;
+        return counters;
+    }
+
+private:
+    struct Event {
+        const char* name;
+        uint32_t type;
+        uint64_t config;
+    };
+
+    std::vector<std::string> names_;
+    std::vector<int> fds_;
+    std::vector<double> totals_;
+};
+
+// Measures `body`, which performs `ops` operations per call, after a `setup` run before each call
+// that is not timed. Repeats until `options.min_time_ms` is reached and reports the mean.
+inline Result Measure(const Options& options, size_t ops, const std::function<void()>& setup,
+                      const std::function<void()>& body) {
+    using Clock = std::chrono::steady_clock;
+    PerfCounters* counters = options.perf_counters ? &PerfCounters::Instance() : nullptr;
+    if (counters) {
+        counters->Reset();
+    }
+    Result result;
+    Clock::duration total{};
+    do {
+        setup();
+        // The counters are toggled outside of the timed region so their syscalls do not skew wall time
+        if (counters) {
+            counters->Start();
+        }
+        const auto start = Clock::now();
+        body();
+        total += Clock::now() - start;
+        if (counters) {
+            counters->Stop();
+        }
+        ++result.repetitions;
+    } while (std::chrono::duration<double, std::milli>(total).count() < options.min_time_ms);
+
+    const double ns = std::chrono::duration<double, std::nano>(total).count();
+    const double total_ops = static_cast<double>(ops) * static_cast<double>(result.repetitions);
+    result.ns_per_op = total_ops > 0 ? ns / total_ops : 0;
+    result.ops_per_sec = ns > 0 ? total_ops * 1e9 / ns : 0;
+    if (counters) {
+        counters->Report(total_ops, result.extra);
+    }
+    return result;
+}
+
+// Writes `s` as a JSON string literal.
+inline void WriteJsonString(std::ostream& out, const std::string& s) {
+    out << '"';
+    for (const char c : s) {
+        if (c == '"' || c == '\\') {
+            out << '\\';
+        }
+        out << c;
+    }
+    out << '"';
+}
+
+// Writes `results` as a JSON array of objects, one per line.
+inline void WriteJson(std::ostream& out, const std::vector<Result>& results) {
+    out << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "  {\"suite\": ";
+        WriteJsonString(out, r.suite);
+        out << ", \"container\": ";
+        WriteJsonString(out, r.container);
+        out << ", \"operation\": ";
+        WriteJsonString(out, r.operation);
+        out << ", \"element_bytes\": " << r.element_bytes << ", \"count\": " << r.count
+            << ", \"repetitions\": " << r.repetitions << ", \"ns_per_op\": " << r.ns_per_op
+            << ", \"ops_per_sec\": " << r.ops_per_sec << ", \"bytes_per_sec\": " << r.bytes_per_sec;
+        for (const auto& [name, value] : r.extra) {
+            out << ", ";
+            WriteJsonString(out, name);
+            out << ": " << value;
+        }
+        for (const auto& [name, value] : r.labels) {
+            out << ", ";
+            WriteJsonString(out, name);
+            out << ": ";
+            WriteJsonString(out, value);
+        }
+        out << (i + 1 < results.size() ? "},\n" : "}\n");
+    }
+    out << "]\n";
+}
+
+} // namespace bench
@@ -0,0 +1,213 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <utility>
+
+// A copy-on-write vector: copies share one reference-counted Vector in O(1), and the first mutating
+// call on a shared copy (PushBack(), Erase(), non-const operator[] or begin(), ...) detaches it by
+// deep-copying the elements. The reference count is atomic, so copies may be passed between threads;
+// a single CowVector object still must not be mutated from several threads at once.
+//
+// Non-const element access detaches, so read through a const reference (or cbegin()/cend()) to keep sharing.
+template <typename T>
+class CowVector {
+public: // ------- Types -------
+
+    using iterator = T*;
+    using const_iterator = const T*;
+
+public: // ------- Constructors / Destructor -------
+
+    CowVector() = default;
+
+    explicit CowVector(size_t size)
+        : block_(new Block(size)) {
+    }
+
+    CowVector(const CowVector& other) noexcept
+        : block_(other.block_) {
+        if (block_) {
+            block_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowVector(CowVector&& other) noexcept {
+        this->Swap(other);
+    }
+
+    ~CowVector() {
+        Release();
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() {
+        return Mutable().begin();
+    }
+    iterator end() {
+        return Mutable().end();
+    }
+    const_iterator begin() const noexcept {
+        return block_ ? block_->data.begin() : nullptr;
+    }
+    const_iterator end() const noexcept {
+        return block_ ? block_->data.end() : nullptr;
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Get size of the vector.
+    size_t Size() const noexcept {
+        return block_ ? block_->data.Size() : 0;
+    }
+    // Get capacity of the vector.
+    size_t Capacity() const noexcept {
+        return block_ ? block_->data.Capacity() : 0;
+    }
+
+    // Get the number of CowVector objects sharing the elements, 0 for a vector that never allocated.
+    size_t UseCount() const noexcept {
+        return block_ ? block_->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    // Reserve memory for `new_capacity` elements.
+    void Reserve(size_t new_capacity) {
+        Mutable().Reserve(new_capacity);
+    }
+
+    // Changes the size of the vector to fit new_size.
+    void Resize(size_t new_size) {
+        Mutable().Resize(new_size);
+    }
+
+    // Adds `value` to the back of the vector.
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Constructs an element at the back of the the vector with `args` parameters.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        // The arguments may refer to the shared elements, which stay alive in the other copies while detaching
+        return Mutable().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Removes the last element of the vector.
+    void PopBack() {
+        if (Size() > 0) {
+            Mutable().PopBack();
+        }
+    }
+
+    // Construct an element at `pos` of the vector with `args` parameters.
+    // @returns a pointer to the constructed element.
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        assert(pos >= cbegin() && pos <= cend());
+        // Detaching moves the elements, so `pos` is carried over as an index
+        const size_t distance = pos - cbegin();
+        Vector<T>& data = Mutable();
+        return data.Emplace(data.cbegin() + distance, std::forward<Args>(args)...);
+    }
+
+    // Inserts `value` at the `pos` position.
+    // @returns iterator to the inserted element
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Erases an element at `pos` and returns the iterator to the new element at this position.
+    iterator Erase(const_iterator pos) {
+        assert(pos >= cbegin() && pos < cend());
+        const size_t distance = pos - cbegin();
+        Vector<T>& data = Mutable();
+        return data.Erase(data.cbegin() + distance);
+    }
+
+    // Swaps the data with `other` vector.
+    void Swap(CowVector& other) noexcept {
+        std::swap(block_, other.block_);
+    }
+
+public: // ------- Operators -------
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return block_->data[index];
+    }
+    T& operator[](size_t index) {
+        assert(index < Size());
+        return Mutable()[index];
+    }
+
+    CowVector& operator=(const CowVector& other) noexcept {
+        if (this != &other) {
+            CowVector other_copy(other);
+            this->Swap(other_copy);
+        }
+        return *this;
+    }
+    CowVector& operator=(CowVector&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    struct Block {
+        explicit Block(size_t size)
+            : data(size) {
+        }
+        // Copies `other` into room for twice its elements (or its capacity, if larger), so the mutation
+        // that detached the copy, typically a PushBack(), does not reallocate it right away.
+        explicit Block(const Vector<T>& other)
+            : data(other.Placement()) {
+            data.Reserve(std::max(other.Capacity(), other.Size() * 2));
+            for (const T& value : other) {
+                data.PushBack(value);
+            }
+        }
+
+        std::atomic<size_t> refs{1};
+        Vector<T> data;
+    };
+
+    // Get the elements for modification, deep-copying them first if they are shared.
+    Vector<T>& Mutable() {
+        if (!block_) {
+            block_ = new Block(0);
+        }
+        else if (block_->refs.load(std::memory_order_acquire) != 1) {
+            Block* copy = new Block(block_->data);
+            Release();
+            block_ = copy;
+        }
+        return block_->data;
+    }
+
+    void Release() noexcept {
+        if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete block_;
+        }
+        block_ = nullptr;
+    }
+
+private:
+    Block* block_ = nullptr;
+};
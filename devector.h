@@ -0,0 +1,341 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// A double-ended vector: the elements are contiguous in one RawMemory block like in Vector, but
+// spare capacity is kept in front of them as well as behind them, so PushFront() is amortized O(1)
+// just like PushBack(). Emplace() and Erase() shift whichever side of the position is shorter.
+//
+// A push into a full end reallocates: if more than half of the block is free, the elements are
+// re-centred in a block of the same capacity, otherwise the capacity doubles and all new room goes
+// to the end that ran out, keeping the spare capacity at the other end as it was.
+template <typename T>
+class Devector {
+public: // ------- Types -------
+
+    using iterator = T*;
+    using const_iterator = const T*;
+
+public: // ------- Constructors / Destructor -------
+
+    Devector() = default;
+
+    explicit Devector(size_t size)
+        : data_(size) {
+        std::uninitialized_value_construct_n(data_.GetAddress(), size);
+        size_ = size;
+    }
+
+    Devector(const Devector& other)
+        : data_(other.size_) {
+        std::uninitialized_copy_n(other.begin(), other.size_, data_.GetAddress());
+        size_ = other.size_;
+    }
+
+    Devector(Devector&& other) noexcept {
+        this->Swap(other);
+    }
+
+    ~Devector() {
+        std::destroy_n(begin(), size_);
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() noexcept {
+        return data_ + front_;
+    }
+    iterator end() noexcept {
+        return data_ + front_ + size_;
+    }
+    const_iterator begin() const noexcept {
+        return data_ + front_;
+    }
+    const_iterator end() const noexcept {
+        return data_ + front_ + size_;
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Get size of the vector.
+    size_t Size() const noexcept {
+        return size_;
+    }
+    // Get capacity of the whole block.
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+    // Get the number of free slots in front of the first element.
+    size_t FrontCapacity() const noexcept {
+        return front_;
+    }
+    // Get the number of free slots behind the last element.
+    size_t BackCapacity() const noexcept {
+        return Capacity() - front_ - size_;
+    }
+
+    // Makes sure `count` elements can be added at the front without reallocating.
+    void ReserveFront(size_t count) {
+        if (count > FrontCapacity()) {
+            Reallocate(count + size_ + BackCapacity(), count);
+        }
+    }
+    // Makes sure `count` elements can be added at the back without reallocating.
+    void ReserveBack(size_t count) {
+        if (count > BackCapacity()) {
+            Reallocate(front_ + size_ + count, front_);
+        }
+    }
+
+    // Get the first and the last element.
+    T& Front() noexcept {
+        assert(size_ > 0);
+        return *begin();
+    }
+    const T& Front() const noexcept {
+        assert(size_ > 0);
+        return *begin();
+    }
+    T& Back() noexcept {
+        assert(size_ > 0);
+        return *(end() - 1);
+    }
+    const T& Back() const noexcept {
+        assert(size_ > 0);
+        return *(end() - 1);
+    }
+
+    // Adds `value` to the back of the vector.
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Constructs an element at the back of the vector with `args` parameters.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (BackCapacity() == 0) {
+            return *GrowAndEmplace(false, std::forward<Args>(args)...);
+        }
+        T* element = new (end()) T(std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    // Adds `value` to the front of the vector.
+    void PushFront(const T& value) {
+        EmplaceFront(value);
+    }
+    void PushFront(T&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    // Constructs an element at the front of the vector with `args` parameters.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args) {
+        if (front_ == 0) {
+            return *GrowAndEmplace(true, std::forward<Args>(args)...);
+        }
+        T* element = new (begin() - 1) T(std::forward<Args>(args)...);
+        --front_;
+        ++size_;
+        return *element;
+    }
+
+    // Removes the first element of the vector.
+    void PopFront() noexcept {
+        if (size_ > 0) {
+            std::destroy_at(begin());
+            ++front_;
+            --size_;
+        }
+    }
+    // Removes the last element of the vector.
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            std::destroy_at(end() - 1);
+            --size_;
+        }
+    }
+
+    // Construct an element at `pos` of the vector with `args` parameters, shifting the elements on the
+    // shorter side of `pos` by one.
+    // @returns a pointer to the constructed element.
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        const size_t distance = pos - cbegin();
+        if (distance == 0) {
+            return &EmplaceFront(std::forward<Args>(args)...);
+        }
+        if (distance == size_) {
+            return &EmplaceBack(std::forward<Args>(args)...);
+        }
+        // The arguments may refer to elements that are about to be shifted
+        T value(std::forward<Args>(args)...);
+        if (distance < size_ - distance) {
+            if (front_ == 0) {
+                const auto [new_capacity, new_front] = GrowthLayout(true);
+                Reallocate(new_capacity, new_front);
+            }
+            new (begin() - 1) T(std::move(*begin()));
+            try {
+                std::move(begin() + 1, begin() + distance, begin());
+                begin()[distance - 1] = std::move(value);
+            }
+            catch (...) {
+                std::destroy_at(begin() - 1);
+                throw;
+            }
+            --front_;
+        }
+        else {
+            if (BackCapacity() == 0) {
+                const auto [new_capacity, new_front] = GrowthLayout(false);
+                Reallocate(new_capacity, new_front);
+            }
+            new (end()) T(std::move(*(end() - 1)));
+            try {
+                std::move_backward(begin() + distance, end() - 1, end());
+                begin()[distance] = std::move(value);
+            }
+            catch (...) {
+                std::destroy_at(end());
+                throw;
+            }
+        }
+        ++size_;
+        return begin() + distance;
+    }
+
+    // Inserts `value` at the `pos` position.
+    // @returns iterator to the inserted element
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Erases an element at `pos`, shifting the elements on the shorter side of it by one.
+    // @returns the iterator to the new element at this position.
+    iterator Erase(const_iterator pos) {
+        assert(pos >= cbegin() && pos < cend());
+        const size_t distance = pos - cbegin();
+        if (distance < size_ - distance - 1) {
+            std::move_backward(begin(), begin() + distance, begin() + distance + 1);
+            PopFront();
+        }
+        else {
+            std::move(begin() + distance + 1, end(), begin() + distance);
+            PopBack();
+        }
+        return begin() + distance;
+    }
+
+    // Swaps the elements with `other` vector.
+    void Swap(Devector& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(front_, other.front_);
+        std::swap(size_, other.size_);
+    }
+
+public: // ------- Operators -------
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return begin()[index];
+    }
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return begin()[index];
+    }
+
+    Devector& operator=(const Devector& other) {
+        if (this != &other) {
+            Devector other_copy(other);
+            this->Swap(other_copy);
+        }
+        return *this;
+    }
+    Devector& operator=(Devector&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    // Moves (or copies, depending on type properties) the elements to `to`.
+    void Relocate(T* to) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(begin(), size_, to);
+        }
+        else {
+            std::uninitialized_copy_n(begin(), size_, to);
+        }
+    }
+
+    // Relocates the elements into a new block of `new_capacity` slots, starting at slot `new_front`.
+    void Reallocate(size_t new_capacity, size_t new_front) {
+        RawMemory<T> new_data(new_capacity);
+        Relocate(new_data + new_front);
+        std::destroy_n(begin(), size_);
+        data_.Swap(new_data);
+        front_ = new_front;
+    }
+
+    // Get the capacity and the first element's slot of the block to reallocate to when the front or the
+    // back is full, see the class comment. The new layout has at least one free slot at that end.
+    std::pair<size_t, size_t> GrowthLayout(bool at_front) const noexcept {
+        const size_t free = Capacity() - size_;
+        if (free > size_) {
+            const size_t new_front = at_front ? (free + 1) / 2 : free / 2;
+            return {Capacity(), new_front};
+        }
+        const size_t new_capacity = std::max<size_t>(Capacity() * 2, 1);
+        const size_t new_front = at_front ? new_capacity - size_ - BackCapacity() : front_;
+        return {new_capacity, new_front};
+    }
+
+    // Reallocates for a push into the full front or back and adds an element constructed from `args`
+    // there. It is constructed before the old elements are relocated, since `args` may refer to them.
+    template <typename... Args>
+    T* GrowAndEmplace(bool at_front, Args&&... args) {
+        const auto [new_capacity, new_front] = GrowthLayout(at_front);
+        RawMemory<T> new_data(new_capacity);
+        T* element = new (new_data + (at_front ? new_front - 1 : new_front + size_)) T(std::forward<Args>(args)...);
+        try {
+            Relocate(new_data + new_front);
+        }
+        catch (...) {
+            std::destroy_at(element);
+            throw;
+        }
+        std::destroy_n(begin(), size_);
+        data_.Swap(new_data);
+        front_ = at_front ? new_front - 1 : new_front;
+        ++size_;
+        return element;
+    }
+
+private:
+    RawMemory<T> data_;
+    // Index of the first element in the block.
+    size_t front_ = 0;
+    size_t size_ = 0;
+};
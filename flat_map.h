@@ -0,0 +1,455 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+// Sorted associative containers over one contiguous Vector: FlatSet<K> and FlatMap<K, V>.
+//
+// Lookups are binary searches over adjacent elements instead of pointer chasing through tree nodes,
+// single insertions and erasures shift the tail of the vector in O(n). Build them in bulk instead:
+// the constructors sort and deduplicate their input once, and InsertBatch() merges a batch of k
+// elements in O(n + k) (plus O(k log k) if the batch is not sorted yet). Among equivalent keys the
+// element already in the container, or the first one in the input, is kept.
+
+namespace flat_detail {
+
+struct Identity {
+    template <typename T>
+    const T& operator()(const T& value) const noexcept {
+        return value;
+    }
+};
+
+struct First {
+    template <typename T>
+    const typename T::first_type& operator()(const T& entry) const noexcept {
+        return entry.first;
+    }
+};
+
+// Destroys the elements of `v` from `new_size` on.
+template <typename T>
+void Truncate(Vector<T>& v, size_t new_size) noexcept {
+    while (v.Size() > new_size) {
+        v.PopBack();
+    }
+}
+
+// Sorts `v` by key and removes every element whose key equals the one before it.
+template <typename T, typename KeyOf, typename Compare>
+void SortUnique(Vector<T>& v, KeyOf key_of, const Compare& compare) {
+    auto less = [&](const T& lhs, const T& rhs) {
+        return compare(key_of(lhs), key_of(rhs));
+    };
+    if (!std::is_sorted(v.begin(), v.end(), less)) {
+        std::stable_sort(v.begin(), v.end(), less);
+    }
+    auto last = std::unique(v.begin(), v.end(), [&](const T& lhs, const T& rhs) {
+        return !less(lhs, rhs);
+    });
+    Truncate(v, static_cast<size_t>(last - v.begin()));
+}
+
+// Merges the sorted and deduplicated `batch` into the sorted `v`, skipping the keys `v` already has.
+// The elements are moved into a buffer reserved up front, so for nothrow-movable elements `v` is
+// left unchanged if the allocation fails.
+template <typename T, typename KeyOf, typename Compare>
+void MergeUnique(Vector<T>& v, Vector<T>& batch, KeyOf key_of, const Compare& compare) {
+    Vector<T> merged;
+    merged.Reserve(v.Size() + batch.Size());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < v.Size() && j < batch.Size()) {
+        if (compare(key_of(batch[j]), key_of(v[i]))) {
+            merged.PushBack(std::move(batch[j++]));
+        }
+        else {
+            if (!compare(key_of(v[i]), key_of(batch[j]))) {
+                ++j;
+            }
+            merged.PushBack(std::move(v[i++]));
+        }
+    }
+    for (; i < v.Size(); ++i) {
+        merged.PushBack(std::move(v[i]));
+    }
+    for (; j < batch.Size(); ++j) {
+        merged.PushBack(std::move(batch[j]));
+    }
+    v.Swap(merged);
+}
+
+} // namespace flat_detail
+
+// A sorted set of unique keys stored in a Vector.
+template <typename K, typename Compare = std::less<K>>
+class FlatSet {
+public: // ------- Types -------
+
+    using value_type = K;
+    using const_iterator = const K*;
+
+public: // ------- Constructors -------
+
+    FlatSet() = default;
+
+    // Takes the keys of `keys` in any order, duplicates are dropped.
+    explicit FlatSet(Vector<K>&& keys, const Compare& compare = Compare())
+        : compare_(compare) {
+        keys_.Swap(keys);
+        flat_detail::SortUnique(keys_, flat_detail::Identity(), compare_);
+    }
+
+    template <typename It>
+    FlatSet(It first, It last, const Compare& compare = Compare())
+        : compare_(compare) {
+        for (; first != last; ++first) {
+            keys_.EmplaceBack(*first);
+        }
+        flat_detail::SortUnique(keys_, flat_detail::Identity(), compare_);
+    }
+
+    FlatSet(std::initializer_list<K> keys, const Compare& compare = Compare())
+        : FlatSet(keys.begin(), keys.end(), compare) {
+    }
+
+    FlatSet(const FlatSet& other)
+        : keys_(other.keys_)
+        , compare_(other.compare_) {
+    }
+
+    FlatSet(FlatSet&& other) noexcept
+        : keys_(std::move(other.keys_))
+        , compare_(other.compare_) {
+    }
+
+public: // ------- Methods -------
+
+    const_iterator begin() const noexcept {
+        return keys_.begin();
+    }
+    const_iterator end() const noexcept {
+        return keys_.end();
+    }
+    const_iterator cbegin() const noexcept {
+        return keys_.begin();
+    }
+    const_iterator cend() const noexcept {
+        return keys_.end();
+    }
+
+    // Get the number of keys.
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    // Get the sorted keys.
+    const Vector<K>& Keys() const noexcept {
+        return keys_;
+    }
+
+    // Reserve memory for `new_capacity` keys.
+    void Reserve(size_t new_capacity) {
+        keys_.Reserve(new_capacity);
+    }
+
+    // Get the first key not less than `key`.
+    const_iterator LowerBound(const K& key) const {
+        return std::lower_bound(begin(), end(), key, compare_);
+    }
+    // Get the first key greater than `key`.
+    const_iterator UpperBound(const K& key) const {
+        return std::upper_bound(begin(), end(), key, compare_);
+    }
+
+    // @returns an iterator to `key`, or end() if the set does not contain it.
+    const_iterator Find(const K& key) const {
+        const_iterator it = LowerBound(key);
+        return it != end() && !compare_(key, *it) ? it : end();
+    }
+
+    // Checks whether the set contains `key`.
+    bool Contains(const K& key) const {
+        return Find(key) != end();
+    }
+    // Get the number of keys equal to `key`, 0 or 1.
+    size_t Count(const K& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Inserts `key` unless it is already there, shifting the greater keys up by one.
+    // @returns an iterator to the key in the set and whether it was inserted.
+    std::pair<const_iterator, bool> Insert(const K& key) {
+        const_iterator it = LowerBound(key);
+        if (it != end() && !compare_(key, *it)) {
+            return {it, false};
+        }
+        return {keys_.Insert(it, key), true};
+    }
+    std::pair<const_iterator, bool> Insert(K&& key) {
+        const_iterator it = LowerBound(key);
+        if (it != end() && !compare_(key, *it)) {
+            return {it, false};
+        }
+        return {keys_.Insert(it, std::move(key)), true};
+    }
+
+    // Inserts the keys of `batch`, in any order, in one merge pass.
+    void InsertBatch(Vector<K>&& batch) {
+        flat_detail::SortUnique(batch, flat_detail::Identity(), compare_);
+        flat_detail::MergeUnique(keys_, batch, flat_detail::Identity(), compare_);
+    }
+    template <typename It>
+    void InsertBatch(It first, It last) {
+        Vector<K> batch;
+        for (; first != last; ++first) {
+            batch.EmplaceBack(*first);
+        }
+        InsertBatch(std::move(batch));
+    }
+
+    // Erases `key`, shifting the greater keys down by one.
+    // @returns the number of erased keys, 0 or 1.
+    size_t Erase(const K& key) {
+        const_iterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        keys_.Erase(it);
+        return 1;
+    }
+
+    // Swaps the keys with `other` set.
+    void Swap(FlatSet& other) noexcept {
+        keys_.Swap(other.keys_);
+        std::swap(compare_, other.compare_);
+    }
+
+public: // ------- Operators -------
+
+    FlatSet& operator=(const FlatSet& other) {
+        if (this != &other) {
+            keys_ = other.keys_;
+            compare_ = other.compare_;
+        }
+        return *this;
+    }
+    FlatSet& operator=(FlatSet&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    Vector<K> keys_;
+    Compare compare_;
+};
+
+// A sorted map of unique keys to values stored as key-value pairs in a Vector.
+// The keys must not be modified through the iterators.
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+public: // ------- Types -------
+
+    using value_type = std::pair<K, V>;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+public: // ------- Constructors -------
+
+    FlatMap() = default;
+
+    // Takes the entries of `entries` in any order, for duplicate keys the first entry is kept.
+    explicit FlatMap(Vector<value_type>&& entries, const Compare& compare = Compare())
+        : compare_(compare) {
+        entries_.Swap(entries);
+        flat_detail::SortUnique(entries_, flat_detail::First(), compare_);
+    }
+
+    template <typename It>
+    FlatMap(It first, It last, const Compare& compare = Compare())
+        : compare_(compare) {
+        for (; first != last; ++first) {
+            entries_.EmplaceBack(*first);
+        }
+        flat_detail::SortUnique(entries_, flat_detail::First(), compare_);
+    }
+
+    FlatMap(std::initializer_list<value_type> entries, const Compare& compare = Compare())
+        : FlatMap(entries.begin(), entries.end(), compare) {
+    }
+
+    FlatMap(const FlatMap& other)
+        : entries_(other.entries_)
+        , compare_(other.compare_) {
+    }
+
+    FlatMap(FlatMap&& other) noexcept
+        : entries_(std::move(other.entries_))
+        , compare_(other.compare_) {
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() noexcept {
+        return entries_.begin();
+    }
+    iterator end() noexcept {
+        return entries_.end();
+    }
+    const_iterator begin() const noexcept {
+        return entries_.begin();
+    }
+    const_iterator end() const noexcept {
+        return entries_.end();
+    }
+    const_iterator cbegin() const noexcept {
+        return entries_.begin();
+    }
+    const_iterator cend() const noexcept {
+        return entries_.end();
+    }
+
+    // Get the number of entries.
+    size_t Size() const noexcept {
+        return entries_.Size();
+    }
+
+    // Reserve memory for `new_capacity` entries.
+    void Reserve(size_t new_capacity) {
+        entries_.Reserve(new_capacity);
+    }
+
+    // Get the first entry with a key not less than `key`.
+    iterator LowerBound(const K& key) {
+        return const_cast<iterator>(std::as_const(*this).LowerBound(key));
+    }
+    const_iterator LowerBound(const K& key) const {
+        return std::lower_bound(begin(), end(), key, [this](const value_type& entry, const K& k) {
+            return compare_(entry.first, k);
+        });
+    }
+    // Get the first entry with a key greater than `key`.
+    iterator UpperBound(const K& key) {
+        return const_cast<iterator>(std::as_const(*this).UpperBound(key));
+    }
+    const_iterator UpperBound(const K& key) const {
+        return std::upper_bound(begin(), end(), key, [this](const K& k, const value_type& entry) {
+            return compare_(k, entry.first);
+        });
+    }
+
+    // @returns an iterator to the entry of `key`, or end() if the map does not contain it.
+    iterator Find(const K& key) {
+        return const_cast<iterator>(std::as_const(*this).Find(key));
+    }
+    const_iterator Find(const K& key) const {
+        const_iterator it = LowerBound(key);
+        return it != end() && !compare_(key, it->first) ? it : end();
+    }
+
+    // Checks whether the map contains `key`.
+    bool Contains(const K& key) const {
+        return Find(key) != end();
+    }
+    // Get the number of entries with `key`, 0 or 1.
+    size_t Count(const K& key) const {
+        return Contains(key) ? 1 : 0;
+    }
+
+    // Get the value of `key`, throws std::out_of_range if the map does not contain it.
+    V& At(const K& key) {
+        return const_cast<V&>(std::as_const(*this).At(key));
+    }
+    const V& At(const K& key) const {
+        const_iterator it = Find(key);
+        if (it == end()) {
+            throw std::out_of_range("FlatMap::At: no such key");
+        }
+        return it->second;
+    }
+
+    // Constructs the value of `key` from `args` unless the key is already there.
+    // @returns an iterator to the entry of `key` and whether it was inserted.
+    template <typename... Args>
+    std::pair<iterator, bool> TryEmplace(const K& key, Args&&... args) {
+        iterator it = LowerBound(key);
+        if (it != end() && !compare_(key, it->first)) {
+            return {it, false};
+        }
+        return {entries_.Emplace(it, std::piecewise_construct, std::forward_as_tuple(key),
+                                 std::forward_as_tuple(std::forward<Args>(args)...)), true};
+    }
+
+    // Inserts `entry` unless its key is already there.
+    // @returns an iterator to the entry of the key and whether it was inserted.
+    std::pair<iterator, bool> Insert(const value_type& entry) {
+        return TryEmplace(entry.first, entry.second);
+    }
+    std::pair<iterator, bool> Insert(value_type&& entry) {
+        return TryEmplace(entry.first, std::move(entry.second));
+    }
+
+    // Inserts the entries of `batch`, in any order, in one merge pass; existing keys keep their values.
+    void InsertBatch(Vector<value_type>&& batch) {
+        flat_detail::SortUnique(batch, flat_detail::First(), compare_);
+        flat_detail::MergeUnique(entries_, batch, flat_detail::First(), compare_);
+    }
+    template <typename It>
+    void InsertBatch(It first, It last) {
+        Vector<value_type> batch;
+        for (; first != last; ++first) {
+            batch.EmplaceBack(*first);
+        }
+        InsertBatch(std::move(batch));
+    }
+
+    // Erases the entry of `key`, shifting the greater keys down by one.
+    // @returns the number of erased entries, 0 or 1.
+    size_t Erase(const K& key) {
+        const_iterator it = Find(key);
+        if (it == end()) {
+            return 0;
+        }
+        entries_.Erase(it);
+        return 1;
+    }
+
+    // Swaps the entries with `other` map.
+    void Swap(FlatMap& other) noexcept {
+        entries_.Swap(other.entries_);
+        std::swap(compare_, other.compare_);
+    }
+
+public: // ------- Operators -------
+
+    // Get the value of `key`, inserting a value-initialized one if the map does not contain it.
+    V& operator[](const K& key) {
+        return TryEmplace(key).first->second;
+    }
+
+    FlatMap& operator=(const FlatMap& other) {
+        if (this != &other) {
+            entries_ = other.entries_;
+            compare_ = other.compare_;
+        }
+        return *this;
+    }
+    FlatMap& operator=(FlatMap&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    Vector<value_type> entries_;
+    Compare compare_;
+};
@@ -0,0 +1,350 @@
+#pragma once
+#include "vector.h"
+#include "vector_view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// A sequence for localized edits: the elements fill one RawMemory block except for a gap of free
+// slots at the cursor. Inserting at the cursor constructs into the gap and erasing there widens it,
+// both O(1) amortized without shifting anything. An edit elsewhere first moves the cursor, which costs
+// one move per element between the old and the new position, so a run of nearby edits pays for the
+// jump once instead of shifting the whole tail on every edit like Vector::Emplace().
+template <typename T>
+class GapBuffer {
+public: // ------- Types -------
+
+    // A bidirectional iterator in logical order, skipping the gap.
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using Buffer = std::conditional_t<IsConst, const GapBuffer, GapBuffer>;
+
+        Iterator() = default;
+        Iterator(Buffer* buffer, size_t index) noexcept
+            : buffer_(buffer)
+            , index_(index) {
+        }
+        // A const iterator from a mutable one.
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : buffer_(other.buffer_)
+            , index_(other.index_) {
+        }
+
+        reference operator*() const noexcept {
+            return (*buffer_)[index_];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const Iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        template <bool>
+        friend class Iterator;
+
+        Buffer* buffer_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+public: // ------- Constructors / Destructor -------
+
+    GapBuffer() = default;
+
+    // Reserves room for `capacity` elements, all of it in the gap.
+    explicit GapBuffer(size_t capacity)
+        : data_(capacity)
+        , gap_end_(capacity) {
+    }
+
+    // Copies the elements of `other` in one run, leaving no gap.
+    GapBuffer(const GapBuffer& other)
+        : data_(other.Size()) {
+        const auto [before, after] = other.Spans();
+        std::uninitialized_copy_n(before.Data(), before.Size(), data_.GetAddress());
+        try {
+            std::uninitialized_copy_n(after.Data(), after.Size(), data_.GetAddress() + before.Size());
+        }
+        catch (...) {
+            std::destroy_n(data_.GetAddress(), before.Size());
+            throw;
+        }
+        gap_begin_ = gap_end_ = other.Size();
+    }
+
+    GapBuffer(GapBuffer&& other) noexcept {
+        this->Swap(other);
+    }
+
+    ~GapBuffer() {
+        DestroyAll();
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, Size());
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, Size());
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Get size of the buffer.
+    size_t Size() const noexcept {
+        return Capacity() - GapSize();
+    }
+    // Get capacity of the buffer.
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+    // Get the number of free slots at the cursor.
+    size_t GapSize() const noexcept {
+        return gap_end_ - gap_begin_;
+    }
+    // Get the cursor, the logical index the gap is at.
+    size_t Cursor() const noexcept {
+        return gap_begin_;
+    }
+
+    // Moves the gap to logical index `pos`, `pos` <= Size(). Moves the elements between the old and the
+    // new cursor across the gap, one move each.
+    void MoveCursor(size_t pos) {
+        assert(pos <= Size());
+        if (GapSize() == 0) {
+            gap_begin_ = gap_end_ = pos;
+            return;
+        }
+        // Every step relocates one element into the gap, so a throwing move leaves the buffer consistent
+        while (gap_begin_ > pos) {
+            new (data_ + gap_end_ - 1) T(std::move(data_[gap_begin_ - 1]));
+            std::destroy_at(data_ + gap_begin_ - 1);
+            --gap_begin_;
+            --gap_end_;
+        }
+        while (gap_begin_ < pos) {
+            new (data_ + gap_begin_) T(std::move(data_[gap_end_]));
+            std::destroy_at(data_ + gap_end_);
+            ++gap_begin_;
+            ++gap_end_;
+        }
+    }
+
+    // Reserve memory for at least `new_capacity` elements; the extra room goes to the gap.
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > Capacity()) {
+            Reallocate(new_capacity);
+        }
+    }
+
+    // Constructs an element at the cursor with `args` parameters, the cursor moves past it.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    T& Emplace(Args&&... args) {
+        if (GapSize() == 0) {
+            return *GrowAndEmplace(std::forward<Args>(args)...);
+        }
+        T* element = new (data_ + gap_begin_) T(std::forward<Args>(args)...);
+        ++gap_begin_;
+        return *element;
+    }
+
+    // Inserts `value` at the cursor, the cursor moves past it.
+    void Insert(const T& value) {
+        Emplace(value);
+    }
+    void Insert(T&& value) {
+        Emplace(std::move(value));
+    }
+
+    // Moves the cursor to `pos` and inserts `value` there, the cursor moves past it.
+    void Insert(size_t pos, const T& value) {
+        // `value` may be one of the elements MoveCursor() relocates
+        T copy(value);
+        MoveCursor(pos);
+        Emplace(std::move(copy));
+    }
+    void Insert(size_t pos, T&& value) {
+        T moved(std::move(value));
+        MoveCursor(pos);
+        Emplace(std::move(moved));
+    }
+
+    // Removes `count` elements before the cursor, like a backspace.
+    void EraseBefore(size_t count = 1) noexcept {
+        assert(count <= gap_begin_);
+        std::destroy_n(data_ + gap_begin_ - count, count);
+        gap_begin_ -= count;
+    }
+    // Removes `count` elements after the cursor, like a delete.
+    void EraseAfter(size_t count = 1) noexcept {
+        assert(count <= Capacity() - gap_end_);
+        std::destroy_n(data_ + gap_end_, count);
+        gap_end_ += count;
+    }
+
+    // Moves the cursor to `pos` and removes `count` elements starting there.
+    void Erase(size_t pos, size_t count = 1) {
+        assert(pos + count <= Size());
+        MoveCursor(pos);
+        EraseAfter(count);
+    }
+
+    // Get the elements in logical order as two contiguous runs of the block: the run before the gap
+    // and the run after it.
+    std::pair<VectorView<T>, VectorView<T>> Spans() noexcept {
+        return {VectorView<T>(data_.GetAddress(), gap_begin_), VectorView<T>(data_ + gap_end_, Capacity() - gap_end_)};
+    }
+    std::pair<VectorView<const T>, VectorView<const T>> Spans() const noexcept {
+        return {VectorView<const T>(data_.GetAddress(), gap_begin_), VectorView<const T>(data_ + gap_end_, Capacity() - gap_end_)};
+    }
+
+    // Swaps the elements with `other` buffer.
+    void Swap(GapBuffer& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(gap_begin_, other.gap_begin_);
+        std::swap(gap_end_, other.gap_end_);
+    }
+
+public: // ------- Operators -------
+
+    // Get the element at logical `index`, skipping the gap.
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return data_[index < gap_begin_ ? index : index + GapSize()];
+    }
+    const T& operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return data_[index < gap_begin_ ? index : index + GapSize()];
+    }
+
+    GapBuffer& operator=(const GapBuffer& other) {
+        if (this != &other) {
+            GapBuffer other_copy(other);
+            this->Swap(other_copy);
+        }
+        return *this;
+    }
+    GapBuffer& operator=(GapBuffer&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    void DestroyAll() noexcept {
+        const auto [before, after] = Spans();
+        std::destroy_n(before.Data(), before.Size());
+        std::destroy_n(after.Data(), after.Size());
+    }
+
+    // Moves (or copies, depending on type properties) the elements to the same sides of the gap in
+    // `to`, a block of `new_capacity` slots. If a copy throws, the copies made so far are destroyed and
+    // the buffer is left unchanged.
+    void Relocate(T* to, size_t new_capacity) {
+        const auto [before, after] = Spans();
+        T* after_to = to + new_capacity - after.Size();
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(before.Data(), before.Size(), to);
+            std::uninitialized_move_n(after.Data(), after.Size(), after_to);
+        }
+        else {
+            std::uninitialized_copy_n(before.Data(), before.Size(), to);
+            try {
+                std::uninitialized_copy_n(after.Data(), after.Size(), after_to);
+            }
+            catch (...) {
+                std::destroy_n(to, before.Size());
+                throw;
+            }
+        }
+    }
+
+    void Reallocate(size_t new_capacity) {
+        RawMemory<T> new_data(new_capacity);
+        Relocate(new_data.GetAddress(), new_capacity);
+        const size_t after = Capacity() - gap_end_;
+        DestroyAll();
+        data_.Swap(new_data);
+        gap_end_ = new_capacity - after;
+    }
+
+    // Doubles the capacity and adds an element constructed from `args` at the cursor. It is constructed
+    // first, since `args` may refer to the old elements.
+    template <typename... Args>
+    T* GrowAndEmplace(Args&&... args) {
+        const size_t new_capacity = Capacity() == 0 ? 1 : Capacity() * 2;
+        RawMemory<T> new_data(new_capacity);
+        T* element = new (new_data + gap_begin_) T(std::forward<Args>(args)...);
+        try {
+            Relocate(new_data.GetAddress(), new_capacity);
+        }
+        catch (...) {
+            std::destroy_at(element);
+            throw;
+        }
+        const size_t after = Capacity() - gap_end_;
+        DestroyAll();
+        data_.Swap(new_data);
+        ++gap_begin_;
+        gap_end_ = new_capacity - after;
+        return element;
+    }
+
+private:
+    RawMemory<T> data_;
+    // The gap is the free slots [gap_begin_, gap_end_) of the block.
+    size_t gap_begin_ = 0;
+    size_t gap_end_ = 0;
+};
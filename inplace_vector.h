@@ -0,0 +1,246 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// A vector with a fixed capacity of `N` elements stored inline in the object itself.
+// It never touches the allocator: operations that would exceed the capacity throw std::bad_alloc,
+// and the Try* variants report a full vector by returning nullptr instead.
+template <typename T, size_t N>
+class InplaceVector {
+public: // ------- Constructors / Destructor -------
+
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    InplaceVector() = default;
+    explicit InplaceVector(size_t size) {
+        CheckCapacity(size);
+        std::uninitialized_value_construct_n(Data(), size);
+        size_ = size;
+    }
+
+    InplaceVector(const InplaceVector& other) {
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    InplaceVector(InplaceVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        std::uninitialized_move_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    ~InplaceVector() {
+        std::destroy_n(Data(), size_);
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() noexcept {
+        return Data();
+    }
+    iterator end() noexcept {
+        return Data() + size_;
+    }
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+    const_iterator end() const noexcept {
+        return Data() + size_;
+    }
+    const_iterator cbegin() const noexcept {
+        return Data();
+    }
+    const_iterator cend() const noexcept {
+        return Data() + size_;
+    }
+
+    // Get size of the vector.
+    size_t Size() const noexcept {
+        return size_;
+    }
+    // Get capacity of the vector, always `N`.
+    static constexpr size_t Capacity() noexcept {
+        return N;
+    }
+
+    // Checks that `new_capacity` elements fit into the vector.
+    void Reserve(size_t new_capacity) {
+        CheckCapacity(new_capacity);
+    }
+
+    // Removes the last element of the vector and decremenets the size by 1.
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            std::destroy_at(Data() + size_ - 1);
+            --size_;
+        }
+    }
+
+    // Changes the size of the vector to fit new_size.
+    void Resize(size_t new_size) {
+        CheckCapacity(new_size);
+        if (size_ > new_size) {
+            std::destroy_n(Data() + new_size, size_ - new_size);
+        }
+        else if (size_ < new_size) {
+            std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    // Adds `value` to the back of the vector.
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Adds `value` to the back of the vector if there is room for it.
+    // @returns a pointer to the added element, or nullptr if the vector is full.
+    T* TryPushBack(const T& value) {
+        return TryEmplaceBack(value);
+    }
+    T* TryPushBack(T&& value) {
+        return TryEmplaceBack(std::move(value));
+    }
+
+    // Constructs an element at the back of the the vector with `args` parameters.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        CheckCapacity(size_ + 1);
+        return *TryEmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Constructs an element at the back of the the vector with `args` parameters if there is room for it.
+    // @returns a pointer to the constructed element, or nullptr if the vector is full.
+    template <typename... Args>
+    T* TryEmplaceBack(Args&&... args) {
+        if (size_ == N) {
+            return nullptr;
+        }
+        T* p_empl_element = new (Data() + size_) T(std::forward<Args>(args)...);
+        ++size_;
+        return p_empl_element;
+    }
+
+    // Construct an element at `pos` of the vector with `args` parameters.
+    // @returns a pointer to the constructed element.
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        assert(pos >= begin() && pos <= end());
+        CheckCapacity(size_ + 1);
+        const size_t distance = pos - begin();
+        if (distance == size_) {
+            return &EmplaceBack(std::forward<Args>(args)...);
+        }
+        // The arguments may refer to elements that are about to be shifted
+        T value(std::forward<Args>(args)...);
+        new (Data() + size_) T(std::move(*(end() - 1)));
+        ++size_;
+        std::move_backward(begin() + distance, end() - 2, end() - 1);
+        Data()[distance] = std::move(value);
+        return begin() + distance;
+    }
+
+    // Inserts `value` at the `pos` position.
+    // @returns iterator to the inserted element
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Erases an element at `pos` and returns the iterator to the new element at this position.
+    iterator Erase(const_iterator pos) {
+        assert(pos >= cbegin() && pos < cend());
+        const size_t distance = pos - cbegin();
+        std::move(begin() + distance + 1, end(), begin() + distance);
+        PopBack();
+        return begin() + distance;
+    }
+
+    // Swaps the elements with `other` vector.
+    void Swap(InplaceVector& other) {
+        InplaceVector& shorter = size_ < other.size_ ? *this : other;
+        InplaceVector& longer = size_ < other.size_ ? other : *this;
+        std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+        std::uninitialized_move(longer.begin() + shorter.size_, longer.end(), shorter.end());
+        std::destroy(longer.begin() + shorter.size_, longer.end());
+        std::swap(size_, other.size_);
+    }
+
+public: // ------- Operators -------
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    InplaceVector& operator=(const InplaceVector& other) {
+        if (this != &other) {
+            AssignFrom(other.Data(), other.size_, [](const T& value) -> const T& {
+                return value;
+            });
+        }
+        return *this;
+    }
+    InplaceVector& operator=(InplaceVector&& other) noexcept(std::is_nothrow_move_assignable_v<T>
+                                                             && std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            AssignFrom(other.Data(), other.size_, [](T& value) -> T&& {
+                return std::move(value);
+            });
+        }
+        return *this;
+    }
+
+private:
+    // Throws std::bad_alloc if `size` elements do not fit into the vector.
+    static void CheckCapacity(size_t size) {
+        if (size > N) {
+            throw std::bad_alloc();
+        }
+    }
+
+    T* Data() noexcept {
+        return std::launder(reinterpret_cast<T*>(storage_));
+    }
+    const T* Data() const noexcept {
+        return std::launder(reinterpret_cast<const T*>(storage_));
+    }
+
+    // Assigns over the common prefix and constructs or destroys the rest, `cast` picks copy or move.
+    template <typename U, typename Cast>
+    void AssignFrom(U* other, size_t other_size, Cast cast) {
+        const size_t common = std::min(size_, other_size);
+        for (size_t i = 0; i < common; ++i) {
+            Data()[i] = cast(other[i]);
+        }
+        if (other_size < size_) {
+            std::destroy_n(Data() + other_size, size_ - other_size);
+        }
+        else {
+            for (size_t i = size_; i < other_size; ++i) {
+                new (Data() + i) T(cast(other[i]));
+                size_ = i + 1;
+            }
+        }
+        size_ = other_size;
+    }
+
+private:
+    alignas(T) unsigned char storage_[(N == 0 ? 1 : N) * sizeof(T)];
+    size_t size_ = 0;
+};
@@ -0,0 +1,412 @@
+#pragma once
+#include "vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+// An immutable vector with structural sharing: a radix-balanced tree of 32-wide chunks.
+//
+// Leaves hold up to 32 elements in a RawMemory block, branches hold up to 32 children. PushBack(),
+// Set() and PopBack() return a new version in O(log32 n) that copies only the path to the changed
+// leaf and shares every other chunk with the old version, so snapshots are O(1) to take and keep.
+// Nodes are reference-counted with atomics, so versions sharing chunks may live on different threads.
+//
+// A Transient (AsTransient()) applies a batch of edits in place: a node is copied only while it is
+// still shared with some other version, after that the transient owns it and edits it directly.
+template <typename T>
+class PersistentVector {
+    struct Node;
+
+public: // ------- Types -------
+
+    class Transient;
+
+    // A read-only forward iterator that walks the elements one chunk at a time.
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator() = default;
+
+        reference operator*() const noexcept {
+            return chunk_[index_ & MASK];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        const_iterator& operator++() noexcept {
+            ++index_;
+            if ((index_ & MASK) == 0 && index_ < vector_->size_) {
+                chunk_ = vector_->ChunkFor(index_);
+            }
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const const_iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        friend class PersistentVector;
+
+        const_iterator(const PersistentVector* vector, size_t index) noexcept
+            : vector_(vector)
+            , chunk_(index < vector->size_ ? vector->ChunkFor(index) : nullptr)
+            , index_(index) {
+        }
+
+        const PersistentVector* vector_ = nullptr;
+        const T* chunk_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public: // ------- Constructors / Destructor -------
+
+    PersistentVector() = default;
+
+    PersistentVector(const PersistentVector& other) noexcept
+        : root_(other.root_)
+        , shift_(other.shift_)
+        , size_(other.size_) {
+        Retain(root_);
+    }
+
+    PersistentVector(PersistentVector&& other) noexcept {
+        this->Swap(other);
+    }
+
+    ~PersistentVector() {
+        Release(root_, shift_);
+    }
+
+public: // ------- Methods -------
+
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Get size of the vector.
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    // @returns a new version with `value` added to the back.
+    PersistentVector PushBack(const T& value) const {
+        PersistentVector result(*this);
+        result.EmplaceBackInPlace(value);
+        return result;
+    }
+    PersistentVector PushBack(T&& value) const {
+        PersistentVector result(*this);
+        result.EmplaceBackInPlace(std::move(value));
+        return result;
+    }
+
+    // @returns a new version with the element at `index` replaced by `value`.
+    PersistentVector Set(size_t index, const T& value) const {
+        PersistentVector result(*this);
+        result.SetInPlace(index, value);
+        return result;
+    }
+    PersistentVector Set(size_t index, T&& value) const {
+        PersistentVector result(*this);
+        result.SetInPlace(index, std::move(value));
+        return result;
+    }
+
+    // @returns a new version without the last element.
+    PersistentVector PopBack() const {
+        PersistentVector result(*this);
+        result.PopBackInPlace();
+        return result;
+    }
+
+    // @returns a transient sharing all chunks with this version, for a batch of in-place edits.
+    Transient AsTransient() const {
+        return Transient(*this);
+    }
+
+    // Swaps the data with `other` vector.
+    void Swap(PersistentVector& other) noexcept {
+        std::swap(root_, other.root_);
+        std::swap(shift_, other.shift_);
+        std::swap(size_, other.size_);
+    }
+
+public: // ------- Operators -------
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return ChunkFor(index)[index & MASK];
+    }
+
+    PersistentVector& operator=(const PersistentVector& other) noexcept {
+        if (this != &other) {
+            PersistentVector other_copy(other);
+            this->Swap(other_copy);
+        }
+        return *this;
+    }
+    PersistentVector& operator=(PersistentVector&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    static constexpr size_t BITS = 5;
+    static constexpr size_t WIDTH = size_t{1} << BITS;
+    static constexpr size_t MASK = WIDTH - 1;
+
+    // Nodes do not know their own kind: a node `shift` levels above the leaves is a Leaf if `shift` is 0.
+    struct Node {
+        std::atomic<size_t> refs{1};
+    };
+    struct Branch : Node {
+        Node* children[WIDTH] = {};
+    };
+    struct Leaf : Node {
+        Leaf()
+            : values(WIDTH) {
+        }
+        ~Leaf() {
+            std::destroy_n(values.GetAddress(), size);
+        }
+        RawMemory<T> values;
+        size_t size = 0;
+    };
+
+    static void Retain(Node* node) noexcept {
+        if (node) {
+            node->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static void Release(Node* node, size_t shift) noexcept {
+        if (!node || node->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        if (shift == 0) {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Branch* branch = static_cast<Branch*>(node);
+        for (Node* child : branch->children) {
+            Release(child, shift - BITS);
+        }
+        delete branch;
+    }
+
+    static Node* NewNode(size_t shift) {
+        if (shift == 0) {
+            return new Leaf;
+        }
+        return new Branch;
+    }
+
+    // Makes the node in `slot` exclusively owned by this version, copying it if it is shared.
+    // @returns the owned node.
+    static Node* Unique(Node*& slot, size_t shift) {
+        if (slot->refs.load(std::memory_order_acquire) == 1) {
+            return slot;
+        }
+        Node* copy = nullptr;
+        if (shift == 0) {
+            const Leaf* from = static_cast<const Leaf*>(slot);
+            auto leaf = std::make_unique<Leaf>();
+            std::uninitialized_copy_n(from->values.GetAddress(), from->size, leaf->values.GetAddress());
+            leaf->size = from->size;
+            copy = leaf.release();
+        }
+        else {
+            const Branch* from = static_cast<const Branch*>(slot);
+            Branch* branch = new Branch;
+            for (size_t i = 0; i < WIDTH; ++i) {
+                branch->children[i] = from->children[i];
+                Retain(branch->children[i]);
+            }
+            copy = branch;
+        }
+        Release(slot, shift);
+        slot = copy;
+        return copy;
+    }
+
+    // Get the chunk of elements holding `index`.
+    const T* ChunkFor(size_t index) const noexcept {
+        const Node* node = root_;
+        for (size_t shift = shift_; shift > 0; shift -= BITS) {
+            node = static_cast<const Branch*>(node)->children[(index >> shift) & MASK];
+        }
+        return static_cast<const Leaf*>(node)->values.GetAddress();
+    }
+
+    // Get the exclusively owned leaf holding `index`, copying the shared nodes on the way down.
+    // Missing nodes are created, so `index` may be Size().
+    Leaf* UniqueLeafFor(size_t index) {
+        Node** slot = &root_;
+        for (size_t shift = shift_; shift > 0; shift -= BITS) {
+            Branch* branch = static_cast<Branch*>(Unique(*slot, shift));
+            slot = &branch->children[(index >> shift) & MASK];
+            if (!*slot) {
+                *slot = NewNode(shift - BITS);
+            }
+        }
+        return static_cast<Leaf*>(Unique(*slot, 0));
+    }
+
+    // If constructing the element throws, the nodes created for it stay empty and are reused next time.
+    template <typename... Args>
+    void EmplaceBackInPlace(Args&&... args) {
+        if (!root_) {
+            root_ = new Leaf;
+            shift_ = 0;
+        }
+        else if (size_ == (WIDTH << shift_)) {
+            Branch* new_root = new Branch;
+            new_root->children[0] = root_;
+            root_ = new_root;
+            shift_ += BITS;
+        }
+        Leaf* leaf = UniqueLeafFor(size_);
+        new (leaf->values + leaf->size) T(std::forward<Args>(args)...);
+        ++leaf->size;
+        ++size_;
+    }
+
+    template <typename U>
+    void SetInPlace(size_t index, U&& value) {
+        assert(index < size_);
+        UniqueLeafFor(index)->values[index & MASK] = std::forward<U>(value);
+    }
+
+    void PopBackInPlace() {
+        assert(size_ > 0);
+        PopBackIn(root_, shift_, size_ - 1);
+        --size_;
+        if (size_ == 0) {
+            shift_ = 0;
+        }
+        // Drop root levels that only hold their first child
+        while (shift_ > 0 && size_ <= (WIDTH << (shift_ - BITS))) {
+            Node* child = static_cast<Branch*>(root_)->children[0];
+            Retain(child);
+            Release(root_, shift_);
+            root_ = child;
+            shift_ -= BITS;
+        }
+    }
+
+    // Removes the element at `index`, the last one, from the subtree in `slot` and frees emptied nodes.
+    void PopBackIn(Node*& slot, size_t shift, size_t index) {
+        if (shift == 0) {
+            Leaf* leaf = static_cast<Leaf*>(Unique(slot, 0));
+            std::destroy_at(leaf->values + --leaf->size);
+        }
+        else {
+            Branch* branch = static_cast<Branch*>(Unique(slot, shift));
+            PopBackIn(branch->children[(index >> shift) & MASK], shift - BITS, index);
+        }
+        // The subtree is empty once its first element is gone
+        if ((index & ((WIDTH << shift) - 1)) == 0) {
+            Release(slot, shift);
+            slot = nullptr;
+        }
+    }
+
+private:
+    Node* root_ = nullptr;
+    // Number of index bits consumed above the leaves: 0 while the root is a leaf.
+    size_t shift_ = 0;
+    size_t size_ = 0;
+};
+
+// A mutable handle for a batch of edits, see PersistentVector::AsTransient().
+template <typename T>
+class PersistentVector<T>::Transient {
+public: // ------- Constructors -------
+
+    explicit Transient(PersistentVector vector) noexcept
+        : vector_(std::move(vector)) {
+    }
+
+public: // ------- Methods -------
+
+    // Get size of the vector.
+    size_t Size() const noexcept {
+        return vector_.Size();
+    }
+
+    // Adds `value` to the back of the vector.
+    void PushBack(const T& value) {
+        vector_.EmplaceBackInPlace(value);
+    }
+    void PushBack(T&& value) {
+        vector_.EmplaceBackInPlace(std::move(value));
+    }
+
+    // Constructs an element at the back of the vector with `args` parameters.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    const T& EmplaceBack(Args&&... args) {
+        vector_.EmplaceBackInPlace(std::forward<Args>(args)...);
+        return vector_[vector_.Size() - 1];
+    }
+
+    // Replaces the element at `index` with `value`.
+    void Set(size_t index, const T& value) {
+        vector_.SetInPlace(index, value);
+    }
+    void Set(size_t index, T&& value) {
+        vector_.SetInPlace(index, std::move(value));
+    }
+
+    // Removes the last element of the vector.
+    void PopBack() {
+        vector_.PopBackInPlace();
+    }
+
+    // @returns an immutable version of the current contents; later edits of the transient do not affect it.
+    PersistentVector Persistent() const& noexcept {
+        return vector_;
+    }
+    PersistentVector Persistent() && noexcept {
+        return std::move(vector_);
+    }
+
+public: // ------- Operators -------
+
+    const T& operator[](size_t index) const noexcept {
+        return vector_[index];
+    }
+
+private:
+    PersistentVector vector_;
+};
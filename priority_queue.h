@@ -0,0 +1,464 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace priority_queue_detail {
+
+inline constexpr size_t CACHE_LINE = 64;
+
+struct alignas(CACHE_LINE) CacheLine {
+    unsigned char bytes[CACHE_LINE];
+};
+
+// The slots of a heap in a block of cache lines, offset so that slot 1, the first child of the root,
+// starts on a line boundary. The children of node i then start i * D * sizeof(T) bytes after it.
+template <typename T>
+class HeapStorage {
+    static_assert(alignof(T) <= CACHE_LINE, "HeapStorage does not align elements beyond a cache line");
+
+public: // ------- Constructors / Destructor -------
+
+    HeapStorage() = default;
+
+    HeapStorage(const HeapStorage& other)
+        : lines_(LinesFor(other.size_)) {
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    HeapStorage(HeapStorage&& other) noexcept {
+        this->Swap(other);
+    }
+
+    ~HeapStorage() {
+        std::destroy_n(Data(), size_);
+    }
+
+public: // ------- Methods -------
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+    size_t Capacity() const noexcept {
+        return lines_.Capacity() == 0 ? 0 : (lines_.Capacity() * CACHE_LINE - PADDING) / sizeof(T);
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity > Capacity()) {
+            RawMemory<CacheLine> new_lines(LinesFor(new_capacity));
+            Relocate(SlotsOf(new_lines));
+            std::destroy_n(Data(), size_);
+            lines_.Swap(new_lines);
+        }
+    }
+
+    // Constructs an element after the last one with `args` parameters, which may refer to elements.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ < Capacity()) {
+            T* element = new (Data() + size_) T(std::forward<Args>(args)...);
+            ++size_;
+            return *element;
+        }
+        RawMemory<CacheLine> new_lines(LinesFor(size_ == 0 ? 1 : size_ * 2));
+        T* element = new (SlotsOf(new_lines) + size_) T(std::forward<Args>(args)...);
+        try {
+            Relocate(SlotsOf(new_lines));
+        }
+        catch (...) {
+            std::destroy_at(element);
+            throw;
+        }
+        std::destroy_n(Data(), size_);
+        lines_.Swap(new_lines);
+        ++size_;
+        return *element;
+    }
+
+    void PopBack() noexcept {
+        assert(size_ > 0);
+        std::destroy_at(Data() + --size_);
+    }
+
+    void Swap(HeapStorage& other) noexcept {
+        lines_.Swap(other.lines_);
+        std::swap(size_, other.size_);
+    }
+
+public: // ------- Operators -------
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    HeapStorage& operator=(const HeapStorage& other) {
+        if (this != &other) {
+            HeapStorage other_copy(other);
+            this->Swap(other_copy);
+        }
+        return *this;
+    }
+    HeapStorage& operator=(HeapStorage&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    // Bytes before slot 0, so that slot 1 starts on a line boundary.
+    static constexpr size_t PADDING = (sizeof(T) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE - sizeof(T);
+
+    static size_t LinesFor(size_t capacity) noexcept {
+        return capacity == 0 ? 0 : (PADDING + capacity * sizeof(T) + CACHE_LINE - 1) / CACHE_LINE;
+    }
+
+    static T* SlotsOf(RawMemory<CacheLine>& lines) noexcept {
+        if (lines.GetAddress() == nullptr) {
+            return nullptr;
+        }
+        return std::launder(reinterpret_cast<T*>(lines.GetAddress()->bytes + PADDING));
+    }
+    T* Data() noexcept {
+        return SlotsOf(lines_);
+    }
+    const T* Data() const noexcept {
+        return SlotsOf(const_cast<RawMemory<CacheLine>&>(lines_));
+    }
+
+    // Moves (or copies, depending on type properties) the elements to `to`. If a copy throws, the
+    // copies made so far are destroyed and the storage is left unchanged.
+    void Relocate(T* to) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(Data(), size_, to);
+        }
+        else {
+            std::uninitialized_copy_n(Data(), size_, to);
+        }
+    }
+
+private:
+    RawMemory<CacheLine> lines_;
+    size_t size_ = 0;
+};
+
+// The `place` callback of a heap whose positions are not tracked.
+struct NoPlace {
+    void operator()(size_t /*position*/) const noexcept {
+    }
+};
+
+// Moves the element at `position` up while it compares after its parent, shifting the parents down
+// into the hole instead of swapping. `place` is called with every position an element lands on.
+template <size_t D, typename T, typename Less, typename Place>
+void SiftUp(HeapStorage<T>& heap, size_t position, const Less& less, Place place) {
+    T entry = std::move(heap[position]);
+    while (position > 0) {
+        const size_t parent = (position - 1) / D;
+        if (!less(heap[parent], entry)) {
+            break;
+        }
+        heap[position] = std::move(heap[parent]);
+        place(position);
+        position = parent;
+    }
+    heap[position] = std::move(entry);
+    place(position);
+}
+
+// Moves the element at `position` down while one of its children compares after it.
+template <size_t D, typename T, typename Less, typename Place>
+void SiftDown(HeapStorage<T>& heap, size_t position, const Less& less, Place place) {
+    const size_t size = heap.Size();
+    T entry = std::move(heap[position]);
+    while (true) {
+        const size_t first = position * D + 1;
+        if (first >= size) {
+            break;
+        }
+        const size_t last = first + D < size ? first + D : size;
+        size_t best = first;
+        for (size_t child = first + 1; child < last; ++child) {
+            if (less(heap[best], heap[child])) {
+                best = child;
+            }
+        }
+        if (!less(entry, heap[best])) {
+            break;
+        }
+        heap[position] = std::move(heap[best]);
+        place(position);
+        position = best;
+    }
+    heap[position] = std::move(entry);
+    place(position);
+}
+
+// Sifts down every node that has children, the last one first: a bottom-up heap build in O(n).
+template <size_t D, typename T, typename Less, typename Place>
+void MakeHeap(HeapStorage<T>& heap, const Less& less, Place place) {
+    if (heap.Size() > 1) {
+        for (size_t i = (heap.Size() - 2) / D + 1; i-- > 0;) {
+            SiftDown<D>(heap, i, less, place);
+        }
+    }
+}
+
+// Removes the root of a non-empty heap, moving the last element into its place.
+template <size_t D, typename T, typename Less, typename Place>
+void PopRoot(HeapStorage<T>& heap, const Less& less, Place place) {
+    if (heap.Size() > 1) {
+        heap[0] = std::move(heap[heap.Size() - 1]);
+        heap.PopBack();
+        SiftDown<D>(heap, 0, less, place);
+    }
+    else {
+        heap.PopBack();
+    }
+}
+
+}  // namespace priority_queue_detail
+
+// A priority queue stored as a D-ary heap: node i has its children at i * D + 1 ... i * D + D, so a
+// sift-down takes about log_D(n) levels instead of the log_2(n) of a binary heap, at the price of
+// D - 1 comparisons per level. The heap lives in cache-line-aligned storage, offset so that the
+// children of the root start on a line boundary and those of node i start i * D * sizeof(T) bytes
+// later. When D * sizeof(T) is a multiple of the 64-byte line every group of siblings starts on a
+// line boundary; when it divides the line, as for D = 4 or 8 and elements of 4 or 8 bytes, every
+// group lies within one line and a sift-down reads one line per level.
+//
+// As with std::priority_queue, Top() is the element that no other element compares after: the largest
+// one for std::less, the smallest one for std::greater. Elements cannot be addressed once pushed; see
+// AddressablePriorityQueue for DecreaseKey().
+template <typename T, typename Compare = std::less<T>, size_t D = 4>
+class PriorityQueue {
+    static_assert(D >= 2, "PriorityQueue needs at least two children per node");
+
+public: // ------- Constructors -------
+
+    PriorityQueue() = default;
+
+    explicit PriorityQueue(const Compare& compare)
+        : compare_(compare) {
+    }
+
+    // Builds the queue from `values` in O(n).
+    explicit PriorityQueue(Vector<T>&& values, const Compare& compare = Compare())
+        : compare_(compare) {
+        Heapify(std::move(values));
+    }
+
+public: // ------- Methods -------
+
+    // Get the number of elements in the queue.
+    size_t Size() const noexcept {
+        return heap_.Size();
+    }
+
+    // Get the element with the highest priority.
+    const T& Top() const noexcept {
+        assert(Size() > 0);
+        return heap_[0];
+    }
+
+    // Replaces the contents of the queue with `values`, heapifying them bottom-up in O(n).
+    void Heapify(Vector<T>&& values) {
+        priority_queue_detail::HeapStorage<T> heap;
+        heap.Reserve(values.Size());
+        for (size_t i = 0; i < values.Size(); ++i) {
+            heap.EmplaceBack(std::move(values[i]));
+        }
+        heap_.Swap(heap);
+        priority_queue_detail::MakeHeap<D>(heap_, compare_, priority_queue_detail::NoPlace());
+    }
+
+    // Adds `value` to the queue in O(log_D n).
+    void Push(const T& value) {
+        Emplace(value);
+    }
+    void Push(T&& value) {
+        Emplace(std::move(value));
+    }
+
+    // Constructs an element with `args` parameters and adds it to the queue in O(log_D n).
+    template <typename... Args>
+    void Emplace(Args&&... args) {
+        heap_.EmplaceBack(std::forward<Args>(args)...);
+        priority_queue_detail::SiftUp<D>(heap_, heap_.Size() - 1, compare_, priority_queue_detail::NoPlace());
+    }
+
+    // Removes Top() from the queue in O(D log_D n).
+    void Pop() {
+        assert(Size() > 0);
+        priority_queue_detail::PopRoot<D>(heap_, compare_, priority_queue_detail::NoPlace());
+    }
+
+private:
+    priority_queue_detail::HeapStorage<T> heap_;
+    [[no_unique_address]] Compare compare_;
+};
+
+// A PriorityQueue whose elements can be addressed: every pushed element gets a Handle which stays valid
+// until the element is popped, so its priority can be raised with DecreaseKey() later. The heap holds
+// the Handle next to every element and every move in a sift records the new position, which costs a
+// wider entry and a write per level; use PriorityQueue where elements are never addressed.
+template <typename T, typename Compare = std::less<T>, size_t D = 4>
+class AddressablePriorityQueue {
+    static_assert(D >= 2, "AddressablePriorityQueue needs at least two children per node");
+
+public: // ------- Types -------
+
+    using Handle = size_t;
+
+public: // ------- Constructors -------
+
+    AddressablePriorityQueue() = default;
+
+    explicit AddressablePriorityQueue(const Compare& compare)
+        : compare_(compare) {
+    }
+
+    // Builds the queue from `values` in O(n), the i-th value gets Handle i.
+    explicit AddressablePriorityQueue(Vector<T>&& values, const Compare& compare = Compare())
+        : compare_(compare) {
+        Heapify(std::move(values));
+    }
+
+public: // ------- Methods -------
+
+    // Get the number of elements in the queue.
+    size_t Size() const noexcept {
+        return heap_.Size();
+    }
+
+    // Get the element with the highest priority.
+    const T& Top() const noexcept {
+        assert(Size() > 0);
+        return heap_[0].value;
+    }
+    // Get the Handle of Top().
+    Handle TopHandle() const noexcept {
+        assert(Size() > 0);
+        return heap_[0].handle;
+    }
+
+    // Checks whether `handle` refers to an element still in the queue.
+    bool Contains(Handle handle) const noexcept {
+        return handle < positions_.Size() && positions_[handle] != NPOS;
+    }
+
+    // Get the element referred to by `handle`.
+    const T& Get(Handle handle) const noexcept {
+        assert(Contains(handle));
+        return heap_[positions_[handle]].value;
+    }
+
+    // Replaces the contents of the queue with `values`, heapifying them bottom-up in O(n).
+    // The i-th value gets Handle i.
+    void Heapify(Vector<T>&& values) {
+        priority_queue_detail::HeapStorage<Entry> heap;
+        heap.Reserve(values.Size());
+        Vector<size_t> positions;
+        positions.Reserve(values.Size());
+        for (size_t i = 0; i < values.Size(); ++i) {
+            heap.EmplaceBack(std::move(values[i]), i);
+            positions.PushBack(i);
+        }
+        heap_.Swap(heap);
+        positions_.Swap(positions);
+        free_handles_ = Vector<Handle>();
+        priority_queue_detail::MakeHeap<D>(heap_, EntryLess(), Recorder());
+    }
+
+    // Adds `value` to the queue in O(log_D n).
+    // @returns the Handle of the added element.
+    Handle Push(const T& value) {
+        return Emplace(value);
+    }
+    Handle Push(T&& value) {
+        return Emplace(std::move(value));
+    }
+
+    // Constructs an element with `args` parameters and adds it to the queue in O(log_D n).
+    // @returns the Handle of the added element.
+    template <typename... Args>
+    Handle Emplace(Args&&... args) {
+        const bool reused = free_handles_.Size() > 0;
+        Handle handle = reused ? free_handles_[free_handles_.Size() - 1] : positions_.Size();
+        if (!reused) {
+            positions_.PushBack(NPOS);
+        }
+        heap_.EmplaceBack(T(std::forward<Args>(args)...), handle);
+        if (reused) {
+            free_handles_.PopBack();
+        }
+        priority_queue_detail::SiftUp<D>(heap_, heap_.Size() - 1, EntryLess(), Recorder());
+        return handle;
+    }
+
+    // Removes Top() from the queue in O(D log_D n); its Handle becomes invalid and may be reused.
+    void Pop() {
+        assert(Size() > 0);
+        const Handle handle = heap_[0].handle;
+        free_handles_.PushBack(handle);
+        positions_[handle] = NPOS;
+        priority_queue_detail::PopRoot<D>(heap_, EntryLess(), Recorder());
+    }
+
+    // Replaces the element referred to by `handle` with `value`, which must not have a lower priority
+    // (it must not compare after the old value), and moves it up towards the top in O(log_D n).
+    void DecreaseKey(Handle handle, T value) {
+        assert(Contains(handle));
+        const size_t position = positions_[handle];
+        assert(!compare_(value, heap_[position].value));
+        heap_[position].value = std::move(value);
+        priority_queue_detail::SiftUp<D>(heap_, position, EntryLess(), Recorder());
+    }
+
+private:
+    static constexpr size_t NPOS = std::numeric_limits<size_t>::max();
+
+    struct Entry {
+        template <typename U>
+        Entry(U&& value, Handle handle)
+            : value(std::forward<U>(value))
+            , handle(handle) {
+        }
+
+        T value;
+        Handle handle;
+    };
+
+    auto EntryLess() const noexcept {
+        return [this](const Entry& lhs, const Entry& rhs) {
+            return compare_(lhs.value, rhs.value);
+        };
+    }
+    // Records the position of the entry that lands on it.
+    auto Recorder() noexcept {
+        return [this](size_t position) noexcept {
+            positions_[heap_[position].handle] = position;
+        };
+    }
+
+private:
+    priority_queue_detail::HeapStorage<Entry> heap_;
+    // The heap position of every Handle, NPOS for handles of popped elements.
+    Vector<size_t> positions_;
+    Vector<Handle> free_handles_;
+    [[no_unique_address]] Compare compare_;
+};
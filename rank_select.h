@@ -0,0 +1,179 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cstdint>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+// A succinct rank/select directory over a packed Vector<bool>.
+//
+// Bits are grouped into 2048-bit blocks of four 512-bit sub-blocks. Every block has one 64-bit entry
+// holding the number of ones before it (relative to its 2^32-bit super-block) and the popcounts of its
+// first three sub-blocks, which makes the directory ~3.1% of the bit vector. Rank1() is then one entry
+// lookup plus at most eight popcounts. Select1() jumps to a block through a sample of every 8192-th one
+// and binary-searches the few blocks between two samples.
+//
+// The index refers to the vector it was built from, which must outlive it and stay unmodified.
+class RankSelect {
+public: // ------- Constructors -------
+
+    explicit RankSelect(const Vector<bool>& bits) : bits_(&bits) {
+        Build();
+    }
+
+public: // ------- Methods -------
+
+    // Get the number of bits in the indexed vector.
+    size_t Size() const noexcept {
+        return bits_->Size();
+    }
+
+    // Get the total number of set bits.
+    size_t Ones() const noexcept {
+        return ones_;
+    }
+
+    // Get the number of set bits in the first `i` bits, `i` <= Size().
+    size_t Rank1(size_t i) const noexcept {
+        assert(i <= Size());
+        const size_t block = i / BLOCK_BITS;
+        const uint64_t entry = blocks_[block];
+        size_t rank = BlockRank(block);
+
+        const size_t sub = (i % BLOCK_BITS) / SUB_BITS;
+        for (size_t j = 0; j < sub; ++j) {
+            rank += SubCount(entry, j);
+        }
+
+        const uint64_t* words = bits_->Words();
+        for (size_t w = block * BLOCK_WORDS + sub * SUB_WORDS; w < i / WORD_BITS; ++w) {
+            rank += Popcount(words[w]);
+        }
+        if (i % WORD_BITS != 0) {
+            rank += Popcount(words[i / WORD_BITS] & ((uint64_t{1} << (i % WORD_BITS)) - 1));
+        }
+        return rank;
+    }
+
+    // Get the number of unset bits in the first `i` bits, `i` <= Size().
+    size_t Rank0(size_t i) const noexcept {
+        return i - Rank1(i);
+    }
+
+    // Get the position of the set bit with zero-based rank `k`, `k` < Ones().
+    size_t Select1(size_t k) const noexcept {
+        assert(k < ones_);
+        // The samples bound the blocks that can hold the k-th one
+        const size_t sample = k / SELECT_SAMPLE;
+        size_t lo = samples_[sample];
+        size_t hi = sample + 1 < samples_.Size() ? samples_[sample + 1] + 1 : blocks_.Size() - 1;
+        while (hi - lo > 1) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (BlockRank(mid) <= k) {
+                lo = mid;
+            }
+            else {
+                hi = mid;
+            }
+        }
+
+        const uint64_t entry = blocks_[lo];
+        size_t rest = k - BlockRank(lo);
+        size_t sub = 0;
+        for (; sub < SUBS_PER_BLOCK - 1 && rest >= SubCount(entry, sub); ++sub) {
+            rest -= SubCount(entry, sub);
+        }
+
+        const uint64_t* words = bits_->Words();
+        for (size_t w = lo * BLOCK_WORDS + sub * SUB_WORDS;; ++w) {
+            const size_t count = Popcount(words[w]);
+            if (rest < count) {
+                return w * WORD_BITS + SelectInWord(words[w], rest);
+            }
+            rest -= count;
+        }
+    }
+
+private:
+    static constexpr size_t WORD_BITS = 64;
+    static constexpr size_t SUB_BITS = 512;
+    static constexpr size_t BLOCK_BITS = 2048;
+    static constexpr size_t SUB_WORDS = SUB_BITS / WORD_BITS;
+    static constexpr size_t BLOCK_WORDS = BLOCK_BITS / WORD_BITS;
+    static constexpr size_t SUBS_PER_BLOCK = BLOCK_BITS / SUB_BITS;
+    // Blocks per super-block: block entries store ranks relative to their super-block in 32 bits.
+    static constexpr size_t SUPER_BLOCK_SHIFT = 21;
+    // Every SELECT_SAMPLE-th one records the block it falls into.
+    static constexpr size_t SELECT_SAMPLE = 8192;
+
+    static size_t Popcount(uint64_t word) noexcept {
+        return static_cast<size_t>(__builtin_popcountll(word));
+    }
+
+    // Get the position of the set bit with zero-based rank `r` inside `word`.
+    static size_t SelectInWord(uint64_t word, size_t r) noexcept {
+#ifdef __BMI2__
+        return static_cast<size_t>(__builtin_ctzll(_pdep_u64(uint64_t{1} << r, word)));
+#else
+        for (; r > 0; --r) {
+            word &= word - 1;
+        }
+        return static_cast<size_t>(__builtin_ctzll(word));
+#endif
+    }
+
+    // Get the popcount of sub-block `j` (< 3) stored in a block `entry`.
+    static size_t SubCount(uint64_t entry, size_t j) noexcept {
+        return static_cast<size_t>((entry >> (32 + 10 * j)) & 0x3ff);
+    }
+
+    // Get the number of ones before `block`.
+    size_t BlockRank(size_t block) const noexcept {
+        return static_cast<size_t>(super_blocks_[block >> SUPER_BLOCK_SHIFT] + (blocks_[block] & 0xffffffff));
+    }
+
+    void Build() {
+        const size_t word_count = bits_->WordCount();
+        const uint64_t* words = bits_->Words();
+        const size_t block_count = (word_count + BLOCK_WORDS - 1) / BLOCK_WORDS;
+
+        // One extra entry past the last block keeps Rank1(Size()) branch-free
+        blocks_.Reserve(block_count + 1);
+        super_blocks_.Reserve((block_count >> SUPER_BLOCK_SHIFT) + 1);
+        uint64_t rank = 0;
+        for (size_t block = 0; block <= block_count; ++block) {
+            if ((block & ((size_t{1} << SUPER_BLOCK_SHIFT) - 1)) == 0) {
+                super_blocks_.PushBack(rank);
+            }
+            uint64_t entry = rank - super_blocks_[block >> SUPER_BLOCK_SHIFT];
+            for (size_t sub = 0; sub < SUBS_PER_BLOCK; ++sub) {
+                uint64_t count = 0;
+                const size_t first = block * BLOCK_WORDS + sub * SUB_WORDS;
+                for (size_t w = first; w < first + SUB_WORDS && w < word_count; ++w) {
+                    count += Popcount(words[w]);
+                }
+                // Sample the block for every multiple of SELECT_SAMPLE the running rank passes in this sub-block
+                for (uint64_t next = (rank + SELECT_SAMPLE - 1) / SELECT_SAMPLE * SELECT_SAMPLE; next < rank + count;
+                     next += SELECT_SAMPLE) {
+                    samples_.PushBack(block);
+                }
+                if (sub < SUBS_PER_BLOCK - 1) {
+                    entry |= count << (32 + 10 * sub);
+                }
+                rank += count;
+            }
+            blocks_.PushBack(entry);
+        }
+        ones_ = static_cast<size_t>(rank);
+    }
+
+private:
+    const Vector<bool>* bits_ = nullptr;
+    Vector<uint64_t> blocks_;
+    Vector<uint64_t> super_blocks_;
+    Vector<size_t> samples_;
+    size_t ones_ = 0;
+};
@@ -0,0 +1,385 @@
+#pragma once
+#include "vector.h"
+#include "vector_view.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+// What a full RingBuffer does on a push.
+enum class RingOverflow {
+    Grow,      // Move the elements into a buffer of twice the capacity
+    Overwrite  // Replace the element at the opposite end: PushBack drops the front, PushFront the back
+};
+
+// A double-ended queue in one RawMemory block used as a circle: the capacity is a power of two, so a
+// logical index maps to a slot with one mask, and pushes and pops at both ends are O(1) without
+// shifting. The elements occupy at most two contiguous runs of the block, see Spans().
+template <typename T>
+class RingBuffer {
+public: // ------- Types -------
+
+    // A bidirectional iterator in logical order, from the front to the back.
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using Buffer = std::conditional_t<IsConst, const RingBuffer, RingBuffer>;
+
+        Iterator() = default;
+        Iterator(Buffer* buffer, size_t index) noexcept
+            : buffer_(buffer)
+            , index_(index) {
+        }
+        // A const iterator from a mutable one.
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : buffer_(other.buffer_)
+            , index_(other.index_) {
+        }
+
+        reference operator*() const noexcept {
+            return (*buffer_)[index_];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const Iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        template <bool>
+        friend class Iterator;
+
+        Buffer* buffer_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+public: // ------- Constructors / Destructor -------
+
+    RingBuffer() = default;
+
+    // Reserves room for `capacity` elements, rounded up to a power of two.
+    explicit RingBuffer(size_t capacity, RingOverflow overflow = RingOverflow::Grow)
+        : overflow_(overflow) {
+        Reserve(capacity);
+    }
+
+    RingBuffer(const RingBuffer& other)
+        : data_(other.data_.Capacity())
+        , overflow_(other.overflow_) {
+        const auto [first, second] = other.Spans();
+        std::uninitialized_copy_n(first.Data(), first.Size(), data_.GetAddress());
+        try {
+            std::uninitialized_copy_n(second.Data(), second.Size(), data_.GetAddress() + first.Size());
+        }
+        catch (...) {
+            std::destroy_n(data_.GetAddress(), first.Size());
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    RingBuffer(RingBuffer&& other) noexcept {
+        this->Swap(other);
+    }
+
+    ~RingBuffer() {
+        DestroyAll();
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Get size of the buffer.
+    size_t Size() const noexcept {
+        return size_;
+    }
+    // Get capacity of the buffer, always 0 or a power of two.
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+    // Get what a push into the full buffer does.
+    RingOverflow Overflow() const noexcept {
+        return overflow_;
+    }
+
+    // Reserve memory for at least `new_capacity` elements, rounded up to a power of two.
+    // The elements are unwrapped into the new block, so that they form one run starting at its beginning.
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        size_t capacity = 1;
+        while (capacity < new_capacity) {
+            capacity *= 2;
+        }
+        RawMemory<T> new_data(capacity);
+        Relocate(new_data.GetAddress());
+        DestroyAll();
+        data_.Swap(new_data);
+        head_ = 0;
+    }
+
+    // Get the first and the last element.
+    T& Front() noexcept {
+        assert(size_ > 0);
+        return (*this)[0];
+    }
+    const T& Front() const noexcept {
+        assert(size_ > 0);
+        return (*this)[0];
+    }
+    T& Back() noexcept {
+        assert(size_ > 0);
+        return (*this)[size_ - 1];
+    }
+    const T& Back() const noexcept {
+        assert(size_ > 0);
+        return (*this)[size_ - 1];
+    }
+
+    // Adds `value` to the back of the buffer.
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Constructs an element at the back of the buffer with `args` parameters.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity() && overflow_ == RingOverflow::Overwrite && size_ > 0) {
+            // The slot after the back is the front's
+            T& slot = data_[head_];
+            slot = T(std::forward<Args>(args)...);
+            head_ = (head_ + 1) & Mask();
+            return slot;
+        }
+        if (size_ == Capacity()) {
+            return *GrowAndEmplace(false, std::forward<Args>(args)...);
+        }
+        T* element = new (data_ + Slot(size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    // Adds `value` to the front of the buffer.
+    void PushFront(const T& value) {
+        EmplaceFront(value);
+    }
+    void PushFront(T&& value) {
+        EmplaceFront(std::move(value));
+    }
+
+    // Constructs an element at the front of the buffer with `args` parameters.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    T& EmplaceFront(Args&&... args) {
+        if (size_ == Capacity() && overflow_ == RingOverflow::Overwrite && size_ > 0) {
+            // The slot before the front is the back's
+            T value(std::forward<Args>(args)...);
+            T& slot = data_[(head_ - 1) & Mask()];
+            slot = std::move(value);
+            head_ = (head_ - 1) & Mask();
+            return slot;
+        }
+        if (size_ == Capacity()) {
+            return *GrowAndEmplace(true, std::forward<Args>(args)...);
+        }
+        const size_t slot = (head_ - 1) & Mask();
+        T* element = new (data_ + slot) T(std::forward<Args>(args)...);
+        head_ = slot;
+        ++size_;
+        return *element;
+    }
+
+    // Removes the first element of the buffer.
+    void PopFront() noexcept {
+        if (size_ > 0) {
+            std::destroy_at(data_ + head_);
+            head_ = (head_ + 1) & Mask();
+            --size_;
+        }
+    }
+    // Removes the first `count` elements of the buffer, `count` <= Size(), e.g. after consuming them through Spans().
+    void PopFront(size_t count) noexcept {
+        assert(count <= size_);
+        for (size_t i = 0; i < count; ++i) {
+            PopFront();
+        }
+    }
+
+    // Removes the last element of the buffer.
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            std::destroy_at(data_ + Slot(size_ - 1));
+            --size_;
+        }
+    }
+
+    // Get the elements in logical order as two contiguous runs of the block: the run from the front up
+    // to the end of the block and the wrapped-around rest, which is empty if the elements do not wrap.
+    std::pair<VectorView<T>, VectorView<T>> Spans() noexcept {
+        const size_t first = std::min(size_, Capacity() - head_);
+        return {VectorView<T>(data_ + head_, first), VectorView<T>(data_.GetAddress(), size_ - first)};
+    }
+    std::pair<VectorView<const T>, VectorView<const T>> Spans() const noexcept {
+        const size_t first = std::min(size_, Capacity() - head_);
+        return {VectorView<const T>(data_ + head_, first), VectorView<const T>(data_.GetAddress(), size_ - first)};
+    }
+
+    // Swaps the elements with `other` buffer.
+    void Swap(RingBuffer& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+        std::swap(overflow_, other.overflow_);
+    }
+
+public: // ------- Operators -------
+
+    // Get the element at logical `index`, counting from the front.
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return data_[Slot(index)];
+    }
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[Slot(index)];
+    }
+
+    RingBuffer& operator=(const RingBuffer& other) {
+        if (this != &other) {
+            RingBuffer other_copy(other);
+            this->Swap(other_copy);
+        }
+        return *this;
+    }
+    RingBuffer& operator=(RingBuffer&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    size_t Mask() const noexcept {
+        return Capacity() - 1;
+    }
+
+    // Get the slot of the block holding logical `index`.
+    size_t Slot(size_t index) const noexcept {
+        return (head_ + index) & Mask();
+    }
+
+    void DestroyAll() noexcept {
+        const auto [first, second] = Spans();
+        std::destroy_n(first.Data(), first.Size());
+        std::destroy_n(second.Data(), second.Size());
+    }
+
+    // Moves (or copies, depending on type properties) the elements in logical order to `to`.
+    // If a copy throws, the copies made so far are destroyed and the buffer is left unchanged.
+    void Relocate(T* to) {
+        const auto [first, second] = Spans();
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(first.Data(), first.Size(), to);
+            std::uninitialized_move_n(second.Data(), second.Size(), to + first.Size());
+        }
+        else {
+            std::uninitialized_copy_n(first.Data(), first.Size(), to);
+            try {
+                std::uninitialized_copy_n(second.Data(), second.Size(), to + first.Size());
+            }
+            catch (...) {
+                std::destroy_n(to, first.Size());
+                throw;
+            }
+        }
+    }
+
+    // Doubles the capacity and adds an element constructed from `args` at the front or the back.
+    // The old elements go to slots [0, Size()) of the new block and the new one right behind them, or
+    // into the last slot to wrap around to the front. It is constructed first, since `args` may refer
+    // to the old elements.
+    template <typename... Args>
+    T* GrowAndEmplace(bool at_front, Args&&... args) {
+        const size_t new_capacity = Capacity() == 0 ? 1 : Capacity() * 2;
+        RawMemory<T> new_data(new_capacity);
+        const size_t slot = at_front ? new_capacity - 1 : size_;
+        T* element = new (new_data + slot) T(std::forward<Args>(args)...);
+        try {
+            Relocate(new_data.GetAddress());
+        }
+        catch (...) {
+            std::destroy_at(element);
+            throw;
+        }
+        DestroyAll();
+        data_.Swap(new_data);
+        head_ = at_front ? slot : 0;
+        ++size_;
+        return element;
+    }
+
+private:
+    RawMemory<T> data_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    RingOverflow overflow_ = RingOverflow::Grow;
+};
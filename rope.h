@@ -0,0 +1,788 @@
+#pragma once
+#include "vector_view.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// A sequence for huge vectors with edits anywhere: the elements are kept in leaf chunks of about 512
+// bytes under a B-tree whose nodes count the elements below them. Indexing, Emplace() and Erase()
+// descend from the root in O(log n) and shift at most one chunk; Concat() and Split() relink
+// O(log n) nodes and move no elements except in the chunks at the seam.
+//
+// All leaves are at the same depth, every node but the root is at least half full, and the elements
+// of a leaf are contiguous, see ForEachChunk().
+template <typename T>
+class Rope {
+    struct Node;
+    struct Leaf;
+    struct Branch;
+
+public: // ------- Types -------
+
+    // A bidirectional iterator that caches the chunk of its element, so stepping through a chunk does
+    // not descend the tree.
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using Container = std::conditional_t<IsConst, const Rope, Rope>;
+
+        Iterator() = default;
+        Iterator(Container* rope, size_t index) noexcept
+            : rope_(rope)
+            , index_(index) {
+            Refresh();
+        }
+        // A const iterator from a mutable one.
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : rope_(other.rope_)
+            , index_(other.index_)
+            , chunk_(other.chunk_)
+            , chunk_first_(other.chunk_first_)
+            , chunk_last_(other.chunk_last_) {
+        }
+
+        reference operator*() const noexcept {
+            return chunk_[index_ - chunk_first_];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            if (index_ >= chunk_last_) {
+                Refresh();
+            }
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            if (index_ < chunk_first_ || index_ >= chunk_last_) {
+                Refresh();
+            }
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --*this;
+            return old;
+        }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const Iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+
+    private:
+        template <bool>
+        friend class Iterator;
+        friend class Rope;
+
+        void Refresh() noexcept {
+            if (index_ < rope_->Size()) {
+                Leaf* leaf = rope_->LeafFor(index_, chunk_first_);
+                chunk_ = leaf->Data();
+                chunk_last_ = chunk_first_ + leaf->size;
+            }
+        }
+
+        Container* rope_ = nullptr;
+        size_t index_ = 0;
+        pointer chunk_ = nullptr;
+        // The logical indices [chunk_first_, chunk_last_) of the elements in `chunk_`.
+        size_t chunk_first_ = 0;
+        size_t chunk_last_ = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+public: // ------- Constructors / Destructor -------
+
+    Rope() = default;
+
+    Rope(const Rope& other)
+        : root_(other.root_ ? CopyNode(other.root_, other.height_) : nullptr)
+        , height_(other.height_) {
+    }
+
+    Rope(Rope&& other) noexcept {
+        this->Swap(other);
+    }
+
+    ~Rope() {
+        Destroy(root_, height_);
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, Size());
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, Size());
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Get size of the rope.
+    size_t Size() const noexcept {
+        return root_ ? root_->size : 0;
+    }
+    // Get the number of levels of the tree, 0 for an empty rope.
+    size_t Height() const noexcept {
+        return root_ ? height_ + 1 : 0;
+    }
+
+    // Adds `value` to the back of the rope.
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Constructs an element at the back of the rope with `args` parameters.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        const size_t index = Size();
+        Emplace(cend(), std::forward<Args>(args)...);
+        return (*this)[index];
+    }
+
+    // Removes the last element of the rope.
+    void PopBack() {
+        if (Size() > 0) {
+            Erase(const_iterator(this, Size() - 1));
+        }
+    }
+
+    // Construct an element at `pos` of the rope with `args` parameters in O(log n).
+    // @returns an iterator to the constructed element.
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        const size_t index = pos.index_;
+        assert(index <= Size());
+        // The arguments may refer to elements that are about to be shifted
+        T value(std::forward<Args>(args)...);
+        if (!root_) {
+            root_ = new Leaf;
+            height_ = 0;
+        }
+        if (Full(root_, height_)) {
+            root_ = GrowRoot(root_, height_);
+            ++height_;
+        }
+        InsertIn(root_, height_, index, std::move(value));
+        return iterator(this, index);
+    }
+
+    // Inserts `value` at the `pos` position.
+    // @returns iterator to the inserted element
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Erases an element at `pos` in O(log n) and returns the iterator to the new element at this position.
+    iterator Erase(const_iterator pos) {
+        const size_t index = pos.index_;
+        assert(index < Size());
+        EraseIn(root_, height_, index);
+        ShrinkRoot();
+        return iterator(this, index);
+    }
+
+    // Appends the elements of `other` in O(log n), leaving `other` empty.
+    void Concat(Rope&& other) {
+        const Tree joined = Join({root_, height_}, {other.root_, other.height_});
+        root_ = joined.root;
+        height_ = joined.height;
+        other.root_ = nullptr;
+        other.height_ = 0;
+    }
+
+    // Moves the elements from `index` on into a new rope in O(log n).
+    // @returns the rope of the moved elements.
+    Rope Split(size_t index) {
+        assert(index <= Size());
+        Rope right;
+        if (!root_) {
+            return right;
+        }
+        const auto [left_tree, right_tree] = SplitTree(root_, height_, index);
+        root_ = left_tree.root;
+        height_ = left_tree.height;
+        right.root_ = right_tree.root;
+        right.height_ = right_tree.height;
+        return right;
+    }
+
+    // Calls `f` with a VectorView of every leaf chunk, in order.
+    template <typename F>
+    void ForEachChunk(F f) {
+        if (root_) {
+            VisitLeaves<T>(root_, height_, f);
+        }
+    }
+    template <typename F>
+    void ForEachChunk(F f) const {
+        if (root_) {
+            VisitLeaves<const T>(root_, height_, f);
+        }
+    }
+
+    // Swaps the elements with `other` rope.
+    void Swap(Rope& other) noexcept {
+        std::swap(root_, other.root_);
+        std::swap(height_, other.height_);
+    }
+
+public: // ------- Operators -------
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        size_t first = 0;
+        Leaf* leaf = LeafFor(index, first);
+        return leaf->Data()[index - first];
+    }
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<Rope&>(*this)[index];
+    }
+
+    Rope& operator=(const Rope& other) {
+        if (this != &other) {
+            Rope other_copy(other);
+            this->Swap(other_copy);
+        }
+        return *this;
+    }
+    Rope& operator=(Rope&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    // Leaves hold up to LEAF_CAPACITY elements in about 512 bytes, branches up to WIDTH children.
+    static constexpr size_t LEAF_CAPACITY = std::max<size_t>(8, 512 / sizeof(T));
+    static constexpr size_t WIDTH = 16;
+
+    // Nodes do not know their own kind: a node `height` levels above the leaves is a Leaf if `height` is 0.
+    struct Node {
+        // Number of elements in the subtree.
+        size_t size = 0;
+    };
+    // The chunk is stored in the leaf itself: one allocation and no indirection per chunk.
+    struct Leaf : Node {
+        Leaf() noexcept {
+        }
+        ~Leaf() {
+            std::destroy_n(Data(), this->size);
+        }
+        T* Data() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+        const T* Data() const noexcept {
+            return std::launder(reinterpret_cast<const T*>(storage));
+        }
+        alignas(T) unsigned char storage[LEAF_CAPACITY * sizeof(T)];
+    };
+    struct Branch : Node {
+        Node* children[WIDTH] = {};
+        size_t count = 0;
+    };
+
+    // A subtree detached from a rope: Split() and Concat() work on these.
+    struct Tree {
+        Node* root = nullptr;
+        size_t height = 0;
+    };
+
+    static void Destroy(Node* node, size_t height) noexcept {
+        if (!node) {
+            return;
+        }
+        if (height == 0) {
+            delete static_cast<Leaf*>(node);
+            return;
+        }
+        Branch* branch = static_cast<Branch*>(node);
+        for (size_t i = 0; i < branch->count; ++i) {
+            Destroy(branch->children[i], height - 1);
+        }
+        delete branch;
+    }
+
+    static Node* CopyNode(const Node* node, size_t height) {
+        if (height == 0) {
+            const Leaf* from = static_cast<const Leaf*>(node);
+            auto leaf = std::make_unique<Leaf>();
+            std::uninitialized_copy_n(from->Data(), from->size, leaf->Data());
+            leaf->size = from->size;
+            return leaf.release();
+        }
+        const Branch* from = static_cast<const Branch*>(node);
+        Branch* branch = new Branch;
+        try {
+            for (; branch->count < from->count; ++branch->count) {
+                branch->children[branch->count] = CopyNode(from->children[branch->count], height - 1);
+            }
+        }
+        catch (...) {
+            Destroy(branch, height);
+            throw;
+        }
+        branch->size = from->size;
+        return branch;
+    }
+
+    static Branch* NewRoot(Node* left, Node* right) {
+        Branch* root = new Branch;
+        root->children[0] = left;
+        root->children[1] = right;
+        root->count = 2;
+        root->size = left->size + right->size;
+        return root;
+    }
+
+    // Get the child of `branch` holding `index` and make `index` relative to it.
+    static size_t ChildFor(const Branch* branch, size_t& index) noexcept {
+        size_t i = 0;
+        while (i + 1 < branch->count && index >= branch->children[i]->size) {
+            index -= branch->children[i]->size;
+            ++i;
+        }
+        return i;
+    }
+
+    // Get the leaf holding `index` and the index of its first element.
+    Leaf* LeafFor(size_t index, size_t& first) const noexcept {
+        Node* node = root_;
+        first = index;
+        for (size_t height = height_; height > 0; --height) {
+            const Branch* branch = static_cast<const Branch*>(node);
+            node = branch->children[ChildFor(branch, index)];
+        }
+        first -= index;
+        return static_cast<Leaf*>(node);
+    }
+
+    template <typename U, typename F>
+    static void VisitLeaves(Node* node, size_t height, F& f) {
+        if (height == 0) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            f(VectorView<U>(leaf->Data(), leaf->size));
+            return;
+        }
+        const Branch* branch = static_cast<const Branch*>(node);
+        for (size_t i = 0; i < branch->count; ++i) {
+            VisitLeaves<U>(branch->children[i], height - 1, f);
+        }
+    }
+
+    // ------- Node fill -------
+
+    static size_t Fill(const Leaf* leaf) noexcept {
+        return leaf->size;
+    }
+    static size_t Fill(const Branch* branch) noexcept {
+        return branch->count;
+    }
+    static constexpr size_t MaxFill(const Leaf*) noexcept {
+        return LEAF_CAPACITY;
+    }
+    static constexpr size_t MaxFill(const Branch*) noexcept {
+        return WIDTH;
+    }
+
+    static bool Full(const Node* node, size_t height) noexcept {
+        if (height == 0) {
+            return Fill(static_cast<const Leaf*>(node)) == LEAF_CAPACITY;
+        }
+        return Fill(static_cast<const Branch*>(node)) == WIDTH;
+    }
+    static bool Underfull(const Node* node, size_t height) noexcept {
+        if (height == 0) {
+            return Fill(static_cast<const Leaf*>(node)) < LEAF_CAPACITY / 2;
+        }
+        return Fill(static_cast<const Branch*>(node)) < WIDTH / 2;
+    }
+
+    // Moves (or copies, depending on type properties) `count` elements at `from` to the back of `leaf`.
+    // If a copy throws, the copies made so far are destroyed and `leaf` is left unchanged.
+    static void Append(Leaf* leaf, T* from, size_t count) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(from, count, leaf->Data() + leaf->size);
+        }
+        else {
+            std::uninitialized_copy_n(from, count, leaf->Data() + leaf->size);
+        }
+        leaf->size += count;
+    }
+
+    // Moves the first `count` elements of `right` to the back of `left`. The rest of `right` is not
+    // shifted but goes to a new leaf that replaces it, so that a throw leaves both leaves unchanged.
+    static void MoveToLeft(Leaf* left, Leaf*& right, size_t count) {
+        std::unique_ptr<Leaf> rest;
+        if (count < right->size) {
+            rest = std::make_unique<Leaf>();
+            Append(rest.get(), right->Data() + count, right->size - count);
+        }
+        Append(left, right->Data(), count);
+        if (rest) {
+            delete right;
+            right = rest.release();
+        }
+        else {
+            std::destroy_n(right->Data(), right->size);
+            right->size = 0;
+        }
+    }
+    // Moves the last `count` elements of `left` to the front of `right`. Unless `right` is empty, they
+    // go to a new leaf together with the elements of `right` and it replaces `right`, so that a throw
+    // leaves both leaves unchanged.
+    static void MoveToRight(Leaf* left, Leaf*& right, size_t count) {
+        T* from = left->Data() + left->size - count;
+        if (right->size == 0) {
+            Append(right, from, count);
+        }
+        else {
+            auto moved = std::make_unique<Leaf>();
+            Append(moved.get(), from, count);
+            Append(moved.get(), right->Data(), right->size);
+            delete right;
+            right = moved.release();
+        }
+        std::destroy_n(from, count);
+        left->size -= count;
+    }
+    static void MoveToLeft(Branch* left, Branch* right, size_t count) noexcept {
+        size_t moved = 0;
+        for (size_t i = 0; i < count; ++i) {
+            moved += right->children[i]->size;
+            left->children[left->count + i] = right->children[i];
+        }
+        std::copy(right->children + count, right->children + right->count, right->children);
+        left->count += count;
+        right->count -= count;
+        left->size += moved;
+        right->size -= moved;
+    }
+    static void MoveToRight(Branch* left, Branch* right, size_t count) noexcept {
+        size_t moved = 0;
+        std::copy_backward(right->children, right->children + right->count, right->children + right->count + count);
+        for (size_t i = 0; i < count; ++i) {
+            Node* child = left->children[left->count - count + i];
+            moved += child->size;
+            right->children[i] = child;
+        }
+        left->count -= count;
+        right->count += count;
+        left->size -= moved;
+        right->size += moved;
+    }
+
+    static void InsertChild(Branch* branch, size_t pos, Node* child) noexcept {
+        assert(branch->count < WIDTH);
+        std::copy_backward(branch->children + pos, branch->children + branch->count, branch->children + branch->count + 1);
+        branch->children[pos] = child;
+        ++branch->count;
+    }
+    static void RemoveChild(Branch* branch, size_t pos) noexcept {
+        std::copy(branch->children + pos + 1, branch->children + branch->count, branch->children + pos);
+        --branch->count;
+    }
+
+    // Fixes the underfull child `pos` of `branch`, which must have another child, by merging it with a
+    // neighbour if both fit into one node and by evening out the two otherwise. A throw leaves `branch`
+    // unchanged.
+    template <typename NodeType>
+    static void RebalancePair(Branch* branch, size_t pos) {
+        const size_t left_pos = pos > 0 ? pos - 1 : pos;
+        NodeType* left = static_cast<NodeType*>(branch->children[left_pos]);
+        NodeType* right = static_cast<NodeType*>(branch->children[left_pos + 1]);
+        const size_t total = Fill(left) + Fill(right);
+        if (total <= MaxFill(left)) {
+            MoveToLeft(left, right, Fill(right));
+            delete right;
+            RemoveChild(branch, left_pos + 1);
+            return;
+        }
+        if (Fill(left) < total / 2) {
+            MoveToLeft(left, right, total / 2 - Fill(left));
+        }
+        else if (Fill(left) > total / 2) {
+            MoveToRight(left, right, Fill(left) - total / 2);
+        }
+        // A leaf move may have replaced `right`
+        branch->children[left_pos + 1] = right;
+    }
+    static void Rebalance(Branch* branch, size_t pos, size_t child_height) {
+        if (child_height == 0) {
+            RebalancePair<Leaf>(branch, pos);
+        }
+        else {
+            RebalancePair<Branch>(branch, pos);
+        }
+    }
+
+    // Moves the upper half of the full child `pos` of `branch`, which is not full, to a new sibling
+    // after it. A throw leaves `branch` unchanged.
+    template <typename NodeType>
+    static void SplitPair(Branch* branch, size_t pos) {
+        NodeType* left = static_cast<NodeType*>(branch->children[pos]);
+        auto right = std::make_unique<NodeType>();
+        NodeType* moved = right.get();
+        MoveToRight(left, moved, Fill(left) / 2);
+        InsertChild(branch, pos + 1, right.release());
+    }
+    static void SplitChild(Branch* branch, size_t pos, size_t child_height) {
+        if (child_height == 0) {
+            SplitPair<Leaf>(branch, pos);
+        }
+        else {
+            SplitPair<Branch>(branch, pos);
+        }
+    }
+
+    // Get a new root over the halves of the full `root`. A throw leaves `root` unchanged.
+    static Branch* GrowRoot(Node* root, size_t height) {
+        auto grown = std::make_unique<Branch>();
+        grown->children[0] = root;
+        grown->count = 1;
+        grown->size = root->size;
+        SplitChild(grown.get(), 0, height);
+        return grown.release();
+    }
+
+    // ------- Insert / Erase -------
+
+    // Inserts `value` at `index` of a leaf that is not full. A throw leaves the size of `leaf` unchanged.
+    static void InsertIntoLeaf(Leaf* leaf, size_t index, T&& value) {
+        T* values = leaf->Data();
+        if (index == leaf->size) {
+            new (values + index) T(std::move(value));
+        }
+        else {
+            new (values + leaf->size) T(std::move(values[leaf->size - 1]));
+            try {
+                std::move_backward(values + index, values + leaf->size - 1, values + leaf->size);
+                values[index] = std::move(value);
+            }
+            catch (...) {
+                std::destroy_at(values + leaf->size);
+                throw;
+            }
+        }
+        ++leaf->size;
+    }
+
+    // Inserts `value` at `index` of the subtree of `node`, which is not full. Full nodes on the way are
+    // split before they are entered, so that a throw at the leaf leaves a valid tree.
+    static void InsertIn(Node* node, size_t height, size_t index, T&& value) {
+        if (height == 0) {
+            InsertIntoLeaf(static_cast<Leaf*>(node), index, std::move(value));
+            return;
+        }
+        Branch* branch = static_cast<Branch*>(node);
+        size_t pos = ChildFor(branch, index);
+        if (Full(branch->children[pos], height - 1)) {
+            SplitChild(branch, pos, height - 1);
+            if (index > branch->children[pos]->size) {
+                index -= branch->children[pos]->size;
+                ++pos;
+            }
+        }
+        InsertIn(branch->children[pos], height - 1, index, std::move(value));
+        ++branch->size;
+    }
+
+    static void EraseIn(Node* node, size_t height, size_t index) {
+        if (height == 0) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            T* values = leaf->Data();
+            std::move(values + index + 1, values + leaf->size, values + index);
+            std::destroy_at(values + --leaf->size);
+            return;
+        }
+        Branch* branch = static_cast<Branch*>(node);
+        const size_t pos = ChildFor(branch, index);
+        EraseIn(branch->children[pos], height - 1, index);
+        --branch->size;
+        if (Underfull(branch->children[pos], height - 1)) {
+            Rebalance(branch, pos, height - 1);
+        }
+    }
+
+    // Drops the root while it is an empty leaf or a branch with one child.
+    void ShrinkRoot() noexcept {
+        while (height_ > 0 && static_cast<Branch*>(root_)->count == 1) {
+            Branch* root = static_cast<Branch*>(root_);
+            root_ = root->children[0];
+            --height_;
+            delete root;
+        }
+        if (height_ == 0 && root_ && root_->size == 0) {
+            delete static_cast<Leaf*>(root_);
+            root_ = nullptr;
+        }
+    }
+
+    // ------- Split / Concat -------
+
+    // Adds `tree`, which is lower than `node`, as the first or the last subtree of its height under
+    // `node`, which is not full, fixing it up if its root is underfull. Full branches on the way are
+    // split before they are entered and merged back if the graft throws, which moves no elements, so
+    // that a throw leaves `node` unchanged.
+    static void Graft(Node* node, size_t height, Tree tree, bool at_front) {
+        Branch* branch = static_cast<Branch*>(node);
+        const size_t size = tree.root->size;
+        if (height - 1 == tree.height) {
+            const size_t pos = at_front ? 0 : branch->count;
+            InsertChild(branch, pos, tree.root);
+            if (Underfull(tree.root, tree.height)) {
+                try {
+                    Rebalance(branch, pos, tree.height);
+                }
+                catch (...) {
+                    RemoveChild(branch, pos);
+                    throw;
+                }
+            }
+        }
+        else {
+            size_t pos = at_front ? 0 : branch->count - 1;
+            const bool split = Full(branch->children[pos], height - 1);
+            if (split) {
+                SplitChild(branch, pos, height - 1);
+                pos += at_front ? 0 : 1;
+            }
+            try {
+                Graft(branch->children[pos], height - 1, tree, at_front);
+            }
+            catch (...) {
+                if (split) {
+                    RebalancePair<Branch>(branch, at_front ? 1 : pos);
+                }
+                throw;
+            }
+        }
+        branch->size += size;
+    }
+
+    // Joins two trees into one holding the elements of `left` followed by those of `right`.
+    static Tree Join(Tree left, Tree right) {
+        if (!left.root) {
+            return right;
+        }
+        if (!right.root) {
+            return left;
+        }
+        if (left.height == right.height) {
+            std::unique_ptr<Branch> root(NewRoot(left.root, right.root));
+            if (Underfull(left.root, left.height) || Underfull(right.root, right.height)) {
+                Rebalance(root.get(), 0, left.height);
+            }
+            if (root->count == 1) {
+                return left;
+            }
+            return {root.release(), left.height + 1};
+        }
+        const bool left_taller = left.height > right.height;
+        const Tree taller = left_taller ? left : right;
+        const Tree lower = left_taller ? right : left;
+        if (!Full(taller.root, taller.height)) {
+            Graft(taller.root, taller.height, lower, !left_taller);
+            return taller;
+        }
+        Branch* root = GrowRoot(taller.root, taller.height);
+        try {
+            Graft(root, taller.height + 1, lower, !left_taller);
+        }
+        catch (...) {
+            RebalancePair<Branch>(root, 1);
+            delete root;
+            throw;
+        }
+        return {root, taller.height + 1};
+    }
+
+    // Get a tree of the children [first, last) of `branch`.
+    static Tree Slice(const Branch* branch, size_t first, size_t last, size_t height) {
+        if (first == last) {
+            return {};
+        }
+        if (last - first == 1) {
+            return {branch->children[first], height - 1};
+        }
+        Branch* slice = new Branch;
+        for (size_t i = first; i < last; ++i) {
+            slice->children[slice->count++] = branch->children[i];
+            slice->size += branch->children[i]->size;
+        }
+        return {slice, height};
+    }
+
+    // Splits the subtree of `node` into the trees of its first `index` elements and of the rest.
+    static std::pair<Tree, Tree> SplitTree(Node* node, size_t height, size_t index) {
+        if (index == 0) {
+            return {{}, {node, height}};
+        }
+        if (index == node->size) {
+            return {{node, height}, {}};
+        }
+        if (height == 0) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            auto right = std::make_unique<Leaf>();
+            Leaf* moved = right.get();
+            MoveToRight(leaf, moved, leaf->size - index);
+            return {{leaf, 0}, {right.release(), 0}};
+        }
+        Branch* branch = static_cast<Branch*>(node);
+        const size_t pos = ChildFor(branch, index);
+        const auto [left_part, right_part] = SplitTree(branch->children[pos], height - 1, index);
+        const Tree before = Slice(branch, 0, pos, height);
+        const Tree after = Slice(branch, pos + 1, branch->count, height);
+        delete branch;
+        return {Join(before, left_part), Join(right_part, after)};
+    }
+
+private:
+    Node* root_ = nullptr;
+    // Number of levels above the leaves: 0 while the root is a leaf.
+    size_t height_ = 0;
+};
@@ -0,0 +1,358 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// A contiguous, non-owning range of elements of one SoAVector column.
+template <typename T>
+class ColumnSpan {
+public:
+    ColumnSpan(T* data, size_t size) noexcept : data_(data), size_(size) {
+    }
+
+    T* begin() const noexcept {
+        return data_;
+    }
+    T* end() const noexcept {
+        return data_ + size_;
+    }
+
+    // Return the pointer to the first element of the column.
+    T* Data() const noexcept {
+        return data_;
+    }
+    // Get the number of elements in the column.
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// A structure-of-arrays vector: every field of a row is stored in its own RawMemory column,
+// so that scans touching a few fields only pull those fields into cache.
+template <typename... Ts>
+class SoAVector {
+    static_assert(sizeof...(Ts) > 0, "SoAVector needs at least one column");
+
+public: // ------- Types -------
+
+    // A proxy for one row: a tuple of references into every column.
+    using reference = std::tuple<Ts&...>;
+    using const_reference = std::tuple<const Ts&...>;
+
+    template <size_t I>
+    using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+public: // ------- Constructors / Destructor -------
+
+    SoAVector() = default;
+
+    explicit SoAVector(size_t size) {
+        Resize(size);
+    }
+
+    SoAVector(const SoAVector& other) {
+        Reserve(other.size_);
+        CopyColumn<0>(other);
+        size_ = other.size_;
+    }
+
+    SoAVector(SoAVector&& other) noexcept {
+        this->Swap(other);
+    }
+
+    ~SoAVector() {
+        DestroyRows(0, size_, std::index_sequence_for<Ts...>{});
+    }
+
+public: // ------- Methods -------
+
+    // Get size of the vector.
+    size_t Size() const noexcept {
+        return size_;
+    }
+    // Get capacity of the vector.
+    size_t Capacity() const noexcept {
+        return capacity_;
+    }
+
+    // Reserve memory for `new_capacity` rows in every column.
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= capacity_) {
+            return;
+        }
+        std::tuple<RawMemory<Ts>...> new_columns{RawMemory<Ts>(new_capacity)...};
+        RelocateColumns(new_columns);
+        columns_.swap(new_columns);
+        capacity_ = new_capacity;
+    }
+
+    // Changes the size of the vector to fit `new_size`, value-constructing the fields of new rows.
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            DestroyRows(new_size, size_, std::index_sequence_for<Ts...>{});
+        }
+        else if (new_size > size_) {
+            Reserve(new_size);
+            ConstructRows<0>(new_size);
+        }
+        size_ = new_size;
+    }
+
+    // Constructs a row at the back of the vector from one value per column.
+    // @returns a proxy reference to the constructed row.
+    template <typename... Args>
+    reference EmplaceBack(Args&&... fields) {
+        static_assert(sizeof...(Args) == sizeof...(Ts), "EmplaceBack needs one argument per column");
+        if (size_ == capacity_) {
+            // The arguments may refer to rows of this vector, so build the row before reallocating
+            std::tuple<Ts...> row(std::forward<Args>(fields)...);
+            Reserve(size_ == 0 ? 1 : size_ * 2);
+            EmplaceFields<0>(std::move(row));
+        }
+        else {
+            EmplaceFields<0>(std::forward_as_tuple(std::forward<Args>(fields)...));
+        }
+        ++size_;
+        return (*this)[size_ - 1];
+    }
+
+    // Adds a row at the back of the vector.
+    void PushBack(const Ts&... fields) {
+        EmplaceBack(fields...);
+    }
+
+    // Removes the last row of the vector.
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            DestroyRows(size_ - 1, size_, std::index_sequence_for<Ts...>{});
+            --size_;
+        }
+    }
+
+    // Erases the row at `index`, shifting the following rows of every column down by one.
+    void Erase(size_t index) {
+        assert(index < size_);
+        EraseInColumns(index, std::index_sequence_for<Ts...>{});
+        PopBack();
+    }
+
+    // Swaps the data with `other` vector.
+    void Swap(SoAVector& other) noexcept {
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        SwapColumns(other, std::index_sequence_for<Ts...>{});
+    }
+
+    // Get the contiguous column of the `I`-th field.
+    template <size_t I>
+    ColumnSpan<column_type<I>> Column() noexcept {
+        return ColumnSpan<column_type<I>>(std::get<I>(columns_).GetAddress(), size_);
+    }
+    template <size_t I>
+    ColumnSpan<const column_type<I>> Column() const noexcept {
+        return ColumnSpan<const column_type<I>>(std::get<I>(columns_).GetAddress(), size_);
+    }
+
+    // Get the `I`-th field of the row at `index`.
+    template <size_t I>
+    column_type<I>& Get(size_t index) noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_)[index];
+    }
+    template <size_t I>
+    const column_type<I>& Get(size_t index) const noexcept {
+        assert(index < size_);
+        return std::get<I>(columns_)[index];
+    }
+
+public: // ------- Operators -------
+
+    reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return RowAt(index, std::index_sequence_for<Ts...>{});
+    }
+    const_reference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return RowAt(index, std::index_sequence_for<Ts...>{});
+    }
+
+    SoAVector& operator=(const SoAVector& other) {
+        if (this != &other) {
+            SoAVector other_copy(other);
+            this->Swap(other_copy);
+        }
+        return *this;
+    }
+    SoAVector& operator=(SoAVector&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+
+    template <size_t... Is>
+    reference RowAt(size_t index, std::index_sequence<Is...>) noexcept {
+        return reference(std::get<Is>(columns_)[index]...);
+    }
+    template <size_t... Is>
+    const_reference RowAt(size_t index, std::index_sequence<Is...>) const noexcept {
+        return const_reference(std::get<Is>(columns_)[index]...);
+    }
+
+    template <size_t... Is>
+    void DestroyRows(size_t from, size_t to, std::index_sequence<Is...>) noexcept {
+        (std::destroy(std::get<Is>(columns_) + from, std::get<Is>(columns_) + to), ...);
+    }
+
+    template <size_t... Is>
+    void SwapColumns(SoAVector& other, std::index_sequence<Is...>) noexcept {
+        (std::get<Is>(columns_).Swap(std::get<Is>(other.columns_)), ...);
+    }
+
+    template <size_t... Is>
+    void EraseInColumns(size_t index, std::index_sequence<Is...>) {
+        (std::move(std::get<Is>(columns_) + index + 1, std::get<Is>(columns_) + size_, std::get<Is>(columns_) + index), ...);
+    }
+
+    // Copies the rows of `other` column by column; on failure the already copied columns are destroyed.
+    template <size_t I>
+    void CopyColumn(const SoAVector& other) {
+        if constexpr (I < sizeof...(Ts)) {
+            std::uninitialized_copy_n(std::get<I>(other.columns_).GetAddress(), other.size_, std::get<I>(columns_).GetAddress());
+            try {
+                CopyColumn<I + 1>(other);
+            }
+            catch (...) {
+                std::destroy_n(std::get<I>(columns_).GetAddress(), other.size_);
+                throw;
+            }
+        }
+    }
+
+    // Checks whether column `I` is relocated by copying: like Vector, moves that may throw are avoided.
+    template <size_t I>
+    static constexpr bool CopiesColumn() noexcept {
+        using T = column_type<I>;
+        return !std::is_nothrow_move_constructible_v<T> && std::is_copy_constructible_v<T>;
+    }
+
+    // Moves (or copies, depending on type properties) every column into `new_columns` and destroys the old rows.
+    // The copied columns go first, so if a copy throws nothing has been moved yet: the copies made so far
+    // are destroyed and the vector is left unchanged.
+    void RelocateColumns(std::tuple<RawMemory<Ts>...>& new_columns) {
+        CopyColumns<0>(new_columns);
+        try {
+            MoveColumns<0>(new_columns);
+        }
+        catch (...) {
+            // Only a move-only column with a throwing move gets here
+            DestroyCopiedColumns<0>(new_columns);
+            throw;
+        }
+        DestroyRows(0, size_, std::index_sequence_for<Ts...>{});
+    }
+
+    // Copies the columns for which CopiesColumn() holds into `new_columns`, rolling back on failure.
+    template <size_t I>
+    void CopyColumns(std::tuple<RawMemory<Ts>...>& new_columns) {
+        if constexpr (I < sizeof...(Ts)) {
+            if constexpr (CopiesColumn<I>()) {
+                auto* to = std::get<I>(new_columns).GetAddress();
+                std::uninitialized_copy_n(std::get<I>(columns_).GetAddress(), size_, to);
+                try {
+                    CopyColumns<I + 1>(new_columns);
+                }
+                catch (...) {
+                    std::destroy_n(to, size_);
+                    throw;
+                }
+            }
+            else {
+                CopyColumns<I + 1>(new_columns);
+            }
+        }
+    }
+
+    // Moves the remaining columns into `new_columns`, rolling back the new elements on failure.
+    template <size_t I>
+    void MoveColumns(std::tuple<RawMemory<Ts>...>& new_columns) {
+        if constexpr (I < sizeof...(Ts)) {
+            if constexpr (!CopiesColumn<I>()) {
+                auto* to = std::get<I>(new_columns).GetAddress();
+                std::uninitialized_move_n(std::get<I>(columns_).GetAddress(), size_, to);
+                try {
+                    MoveColumns<I + 1>(new_columns);
+                }
+                catch (...) {
+                    std::destroy_n(to, size_);
+                    throw;
+                }
+            }
+            else {
+                MoveColumns<I + 1>(new_columns);
+            }
+        }
+    }
+
+    template <size_t I>
+    void DestroyCopiedColumns(std::tuple<RawMemory<Ts>...>& new_columns) noexcept {
+        if constexpr (I < sizeof...(Ts)) {
+            if constexpr (CopiesColumn<I>()) {
+                std::destroy_n(std::get<I>(new_columns).GetAddress(), size_);
+            }
+            DestroyCopiedColumns<I + 1>(new_columns);
+        }
+    }
+
+    // Value-constructs rows [size_, new_size) column by column, rolling back on failure.
+    template <size_t I>
+    void ConstructRows(size_t new_size) {
+        if constexpr (I < sizeof...(Ts)) {
+            auto* first = std::get<I>(columns_) + size_;
+            std::uninitialized_value_construct_n(first, new_size - size_);
+            try {
+                ConstructRows<I + 1>(new_size);
+            }
+            catch (...) {
+                std::destroy_n(first, new_size - size_);
+                throw;
+            }
+        }
+    }
+
+    // Constructs the fields of row `size_` from `fields`, rolling back on failure.
+    template <size_t I, typename Tuple>
+    void EmplaceFields(Tuple&& fields) {
+        if constexpr (I < sizeof...(Ts)) {
+            auto* field = new (std::get<I>(columns_) + size_) column_type<I>(std::get<I>(std::move(fields)));
+            try {
+                EmplaceFields<I + 1>(std::move(fields));
+            }
+            catch (...) {
+                std::destroy_at(field);
+                throw;
+            }
+        }
+    }
+
+private:
+    std::tuple<RawMemory<Ts>...> columns_;
+    size_t size_ = 0;
+    size_t capacity_ = 0;
+};
@@ -1,8 +1,26 @@
 #include "vector.h"
+#include "vector_search.h"
+#include "soa_vector.h"
+#include "rank_select.h"
+#include "inplace_vector.h"
+#include "persistent_vector.h"
+#include "cow_vector.h"
+#include "vector_view.h"
+#include "flat_map.h"
+#include "ring_buffer.h"
+#include "priority_queue.h"
+#include "devector.h"
+#include "gap_buffer.h"
+#include "tiered_vector.h"
+#include "rope.h"
 
 #include <iostream>
+#include <queue>
 #include <stdexcept>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <utility>
 #include <vector>
 #include <algorithm>
 
@@ -553,6 +571,1211 @@ void Test6() {
     }
 }
 
+void Test7() {
+    const size_t SIZE = 4'000'000;
+    const size_t NUM_THREADS = 4;
+    {
+        Vector<int> v(SIZE, ParallelConstruct{NUM_THREADS});
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        assert(std::all_of(v.begin(), v.end(), [](int x) {
+            return x == 0;
+        }));
+    }
+    {
+        Vector<int> v(10);
+        v[9] = 42;
+        v.Resize(SIZE, ParallelConstruct{NUM_THREADS});
+        assert(v.Size() == SIZE);
+        assert(v[9] == 42);
+        assert(v[SIZE - 1] == 0);
+        v.Resize(5, ParallelConstruct{NUM_THREADS});
+        assert(v.Size() == 5);
+        assert(v.Capacity() == SIZE);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(100, ParallelConstruct{NUM_THREADS});  // Too small to spawn threads
+        assert(Obj::num_default_constructed == 100);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+// Checks whether pages can be placed and located here: mbind() and move_pages() fail on kernels without NUMA support.
+bool NumaAvailable() {
+    try {
+        Vector<double> probe(1, PlacementPolicy{MemoryPlacement::Bind, 1ul});
+        return probe.ResidentNodes() == 1ul;
+    } catch (const std::system_error&) {
+        return false;
+    }
+}
+
+void Test8() {
+    if (!NumaAvailable()) {
+        std::cout << "Test8: NUMA placement is not available, skipped" << std::endl;
+        return;
+    }
+    const size_t SIZE = 100'000;
+    {
+        Vector<double> v(PlacementPolicy{MemoryPlacement::Local});
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<double>(i));
+        }
+        assert(v.Placement().placement == MemoryPlacement::Local);
+        assert(v[SIZE - 1] == SIZE - 1);
+        assert(v.ResidentNodes() != 0);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE, PlacementPolicy{MemoryPlacement::Bind, 1ul});
+        v.Reserve(SIZE * 2);
+        assert(v.Placement().placement == MemoryPlacement::Bind);
+        assert(v.ResidentNodes() == 1ul);
+        Vector<Obj> v_copy(v);
+        assert(v_copy.Placement().placement == MemoryPlacement::Bind);
+        v = Vector<Obj>(SIZE);
+        assert(v.Placement().placement == MemoryPlacement::Default);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test9() {
+    using namespace std::literals;
+    {
+        Vector<uint32_t> v;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            v.PushBack(i % 100);
+        }
+        assert(Find(v, 42) == v.begin() + 42);
+        assert(Find(v, 100) == v.end());
+        assert(Count(v, 7) == 10);
+        assert(Contains(v, 99));
+        assert(!Contains(v, 1000));
+        assert(FindFirstNotEqual(v, 0) == v.begin() + 1);
+        assert(MinMax(v) == std::make_pair(0u, 99u));
+        assert(Find(v.begin() + 43, v.end(), 42u) == v.begin() + 142);
+    }
+    {
+        Vector<double> v(37);
+        v[36] = -1.5;
+        v[5] = 2.5;
+        assert(Find(v, 2.5) == v.begin() + 5);
+        assert(FindFirstNotEqual(v, 0.0) == v.begin() + 5);
+        assert(Count(v, 0.0) == 35);
+        assert(MinMax(v) == std::make_pair(-1.5, 2.5));
+    }
+    {
+        Vector<std::string> v;
+        v.PushBack("a"s);
+        v.PushBack("b"s);
+        assert(Find(v, "b"s) == v.begin() + 1);
+        assert(MinMax(v) == std::make_pair("a"s, "b"s));
+    }
+}
+
+void Test10() {
+    using namespace std::literals;
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        SoAVector<int, Obj, std::string> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i), Obj{static_cast<int>(i)}, std::to_string(i));
+        }
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() >= SIZE);
+        assert(std::get<0>(v[10]) == 10);
+        assert(std::get<1>(v[10]).id == 10);
+        assert(std::get<2>(v[10]) == "10"s);
+        assert(Obj::num_copied == 0);
+
+        auto ids = v.Column<0>();
+        assert(ids.Size() == SIZE);
+        assert(&ids[1] - &ids[0] == 1);
+        std::get<0>(v[3]) = 42;
+        assert(ids[3] == 42);
+
+        v.Erase(0);
+        assert(v.Size() == SIZE - 1);
+        assert(v.Get<1>(0).id == 1);
+        assert(v.Get<2>(0) == "1"s);
+
+        v.EmplaceBack(v.Get<0>(0), v.Get<1>(0), v.Get<2>(0));
+        assert(v.Get<2>(SIZE - 1) == "1"s);
+
+        SoAVector<int, Obj, std::string> v_copy(v);
+        assert(v_copy.Size() == v.Size());
+        assert(v_copy.Get<2>(5) == v.Get<2>(5));
+
+        v.Resize(10);
+        assert(v.Size() == 10);
+        v.Resize(20);
+        assert(v.Get<0>(15) == 0 && v.Get<2>(15).empty());
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        SoAVector<int, Obj> v(SIZE);
+        v.Get<1>(SIZE - 1).throw_on_copy = true;
+        try {
+            SoAVector<int, Obj> v_copy(v);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // A column whose move may throw is copied on reallocation; a failing copy must not lose the
+        // columns that would be moved
+        struct ThrowingMove {
+            explicit ThrowingMove(int id)
+                : obj(id) {
+            }
+            ThrowingMove(const ThrowingMove&) = default;
+            ThrowingMove(ThrowingMove&& other) noexcept(false)
+                : obj(std::move(other.obj)) {
+            }
+            Obj obj;
+        };
+        SoAVector<std::string, ThrowingMove> v;
+        v.Reserve(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(std::string(20, 'a') + std::to_string(i), ThrowingMove(static_cast<int>(i)));
+        }
+        v.Get<1>(SIZE - 1).obj.throw_on_copy = true;
+        try {
+            v.Reserve(SIZE * 2);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE && v.Capacity() == SIZE && Obj::GetAliveObjectCount() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v.Get<0>(i) == std::string(20, 'a') + std::to_string(i) && v.Get<1>(i).obj.id == static_cast<int>(i));
+        }
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test11() {
+    const size_t SIZE = 1000;
+    {
+        Vector<bool> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(i % 3 == 0);
+        }
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() >= SIZE);
+        assert(v.Capacity() / 8 <= SIZE / 4);  // Packed: one bit per element
+        assert(v[0] && !v[1] && v[999]);
+        assert(v.Count() == 334);
+        assert(static_cast<size_t>(std::count(v.begin(), v.end(), true)) == 334);
+
+        v[1] = true;
+        v[0] = v[2];
+        assert(!v[0] && v[1]);
+        assert(v.FindFirstSet() == 1);
+
+        auto pos = v.Erase(v.cbegin() + 1);
+        assert(pos - v.begin() == 1);
+        assert(v.Size() == SIZE - 1);
+        for (size_t i = 1; i < v.Size(); ++i) {
+            assert(v[i] == ((i + 1) % 3 == 0));
+        }
+    }
+    {
+        Vector<bool> a(130);
+        Vector<bool> b(130, true);
+        assert(b.Count() == 130);
+        a[5] = true;
+        a[129] = true;
+        b[5] = false;
+        Vector<bool> c(a);
+        c.And(b);
+        assert(c.Count() == 1 && c[129]);
+        c = a;
+        c.Or(b);
+        assert(c.Count() == 130);
+        c.Xor(a);
+        assert(c.Count() == 128 && !c[5] && !c[129]);
+        c.Not();
+        assert(c.Count() == 2 && c[5] && c[129]);
+        assert(c.FindFirstSet() == 5);
+
+        c.Resize(200, true);
+        assert(c.Count() == 72);
+        c.Resize(100);
+        assert(c.Count() == 1);
+        c.Resize(128);
+        assert(c.Count() == 1);
+        c.PopBack();
+        assert(c.Size() == 127);
+    }
+    {
+        Vector<bool> v(10);
+        assert(v.FindFirstSet() == v.Size());
+    }
+}
+
+void Test12() {
+    for (const size_t size : {0, 1, 64, 511, 2048, 100'000}) {
+        for (const size_t stride : {1, 3, 100}) {
+            Vector<bool> bits(size);
+            for (size_t i = 0; i < size; i += stride) {
+                bits[i] = true;
+            }
+            RankSelect index(bits);
+            assert(index.Size() == size);
+            assert(index.Ones() == bits.Count());
+            size_t rank = 0;
+            for (size_t i = 0; i <= size; ++i) {
+                assert(index.Rank1(i) == rank);
+                assert(index.Rank0(i) == i - rank);
+                if (i < size && bits[i]) {
+                    assert(index.Select1(rank) == i);
+                    ++rank;
+                }
+            }
+        }
+    }
+}
+
+void Test13() {
+    using namespace std::literals;
+    const size_t SIZE = 8;
+    {
+        Obj::ResetCounters();
+        InplaceVector<Obj, SIZE> v;
+        static_assert(sizeof(v) >= SIZE * sizeof(Obj));
+        for (int i = 0; i < static_cast<int>(SIZE) - 1; ++i) {
+            v.EmplaceBack(i, "Ivan"s);
+        }
+        assert(v.Size() == SIZE - 1);
+        assert(v.Capacity() == SIZE);
+        assert(v.TryPushBack(Obj{42}) != nullptr);
+        assert(v.TryEmplaceBack(43) == nullptr);
+        try {
+            v.PushBack(Obj{44});
+            assert(false && "Exception is expected");
+        } catch (const std::bad_alloc&) {
+        }
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1].id == 42);
+
+        auto pos = v.Erase(v.cbegin() + 1);
+        assert(pos == v.begin() + 1 && pos->id == 2);
+        pos = v.Emplace(v.cbegin() + 1, 1, "Ivan"s);
+        assert(pos->id == 1 && v[2].id == 2 && v.Size() == SIZE);
+        assert(Obj::num_copied == 0);
+
+        InplaceVector<Obj, SIZE> v_copy(v);
+        assert(v_copy.Size() == SIZE && v_copy[3].id == 3);
+        v_copy.Resize(2);
+        v_copy.Swap(v);
+        assert(v.Size() == 2 && v_copy.Size() == SIZE);
+        v = v_copy;
+        assert(v.Size() == SIZE && v[SIZE - 1].id == 42);
+        v_copy.Resize(1);
+        v = std::move(v_copy);
+        assert(v.Size() == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        InplaceVector<TestObj, SIZE> v(2);
+        v.Insert(v.cbegin(), v[1]);
+        assert(std::all_of(v.begin(), v.end(), [](const TestObj& obj) {
+            return obj.IsAlive();
+        }));
+    }
+}
+
+#if VECTOR_HAS_CONSTEXPR_ALLOC
+// Builds the first `n` squares with every mutating Vector operation and returns their checksum.
+constexpr int ConstexprSquaresChecksum(int n) {
+    Vector<int> v;
+    v.Reserve(1);
+    for (int i = 0; i < n; ++i) {
+        v.EmplaceBack(i * i);
+    }
+    v.Insert(v.cbegin(), -1);
+    v.Erase(v.cbegin());
+    Vector<int> v_copy(v);
+    v_copy.Resize(n + 1);
+    v = v_copy;
+    int sum = 0;
+    for (int x : v) {
+        sum += x;
+    }
+    return sum + static_cast<int>(v.Size());
+}
+#endif
+
+void Test14() {
+#if VECTOR_HAS_CONSTEXPR_ALLOC
+    static_assert(ConstexprSquaresChecksum(10) == 285 + 11);
+    assert(ConstexprSquaresChecksum(10) == 285 + 11);
+#endif
+}
+
+void Test15() {
+    const size_t SIZE = 100;
+    static_assert(sizeof(RawMemory<int>) == sizeof(int*) + sizeof(size_t));
+    static_assert(sizeof(Vector<int>) == sizeof(RawMemory<int>) + sizeof(size_t));
+    {
+        Obj::ResetCounters();
+        Vector<Obj, VectorStats> v(SIZE);
+        assert(v.GetStats().allocations == 1);
+        assert(v.GetStats().bytes_allocated == SIZE * sizeof(Obj));
+        v.Reserve(SIZE * 2);
+        for (size_t i = 0; i < SIZE + 1; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        const VectorStats& stats = v.GetStats();
+        assert(stats.allocations == 3);
+        assert(stats.deallocations == 2);
+        assert(stats.growths == 2);
+        assert(stats.elements_moved == SIZE + SIZE * 2);
+        assert(stats.elements_copied == 0);
+        assert(stats.peak_capacity == SIZE * 4);
+        assert(stats.bytes_allocated == SIZE * 7 * sizeof(Obj));
+        assert(static_cast<size_t>(Obj::num_moved) == stats.elements_moved);
+    }
+    {
+        struct CopyOnly {
+            CopyOnly() = default;
+            CopyOnly(const CopyOnly&) {
+            }
+            CopyOnly& operator=(const CopyOnly&) = default;
+        };
+        Vector<CopyOnly, VectorStats> v(SIZE);
+        v.Insert(v.cbegin(), CopyOnly{});
+        assert(v.GetStats().elements_copied == SIZE);
+        assert(v.GetStats().elements_moved == 0);
+
+        Vector<CopyOnly, VectorStats> v_small;
+        v_small = v;
+        assert(v_small.GetStats().allocations == 1);
+        assert(v_small.GetStats().growths == 1);
+    }
+    {
+        // Emplace inside capacity shifts the tail without emptying any element
+        Vector<std::string> v;
+        v.Reserve(SIZE);
+        for (size_t i = 0; i < 10; ++i) {
+            v.PushBack(std::string(20, static_cast<char>('a' + i)));
+        }
+        v.Emplace(v.cbegin() + 5, 20, 'x');
+        v.Insert(v.cbegin() + 2, v[9]);
+        assert(v.Size() == 12 && v.Capacity() == SIZE);
+        const std::string expected = "abicdexfghij";
+        for (size_t i = 0; i < expected.size(); ++i) {
+            assert(v[i] == std::string(20, expected[i]));
+        }
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test16() {
+    const size_t SIZE = 100;
+    // Losing one of these silently turns every reallocation into copies
+    static_assert(std::is_nothrow_move_constructible_v<Obj>);
+    static_assert(std::is_nothrow_move_constructible_v<Vector<Obj>>);
+    static_assert(std::is_nothrow_move_assignable_v<Vector<Obj>>);
+    Obj::ResetCounters();
+    {
+        Vector<Obj, VectorStats> v(SIZE);
+        const int old_move_count = Obj::num_moved;
+        v.Reserve(SIZE * 2);
+        assert(Obj::num_moved == old_move_count + static_cast<int>(SIZE));
+        assert(Obj::num_copied == 0);
+        assert(v.GetStats().allocations == 2);
+        v.Reserve(SIZE);
+        v.Reserve(SIZE * 2);
+        assert(v.GetStats().allocations == 2);
+    }
+    {
+        Vector<Obj, VectorStats> v;
+        v.Reserve(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(v.GetStats().allocations == 1);
+        assert(Obj::num_moved == static_cast<int>(SIZE));
+        assert(Obj::num_copied == 0);
+    }
+    {
+        // Doubling growth: one allocation per power of two and fewer than two moves per element
+        Obj::ResetCounters();
+        Vector<Obj, VectorStats> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(v.GetStats().allocations == 8);
+        assert(Obj::num_moved < static_cast<int>(SIZE * 2));
+        assert(Obj::num_copied == 0);
+
+        // Edits within capacity neither allocate nor copy
+        v.Reserve(SIZE * 2);
+        const size_t allocations = v.GetStats().allocations;
+        const int old_move_count = Obj::num_moved;
+        v.Insert(v.cbegin() + SIZE / 2, Obj(1));
+        v.Emplace(v.cbegin() + SIZE / 2, 2);
+        v.Erase(v.cbegin());
+        v.PopBack();
+        assert(v.GetStats().allocations == allocations);
+        assert(Obj::num_copied == 0);
+        // The new last element and the inserted temporary are move-constructed, the rest is move-assigned
+        assert(Obj::num_moved == old_move_count + 3);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj, VectorStats> v(SIZE);
+        Vector<Obj, VectorStats> v_half(SIZE / 2);
+        Vector<Obj, VectorStats> v_full(SIZE);
+        v = v_half;
+        assert(Obj::num_assigned == static_cast<int>(SIZE / 2));
+        assert(Obj::num_copied == 0);
+        v = v_full;
+        assert(Obj::num_assigned == static_cast<int>(SIZE));
+        assert(Obj::num_copied == static_cast<int>(SIZE / 2));
+        assert(v.GetStats().allocations == 1);
+
+        const int old_moved = Obj::num_moved;
+        const int old_move_assigned = Obj::num_move_assigned;
+        v = std::move(v_half);
+        v.Swap(v_full);
+        Vector<Obj, VectorStats> v_moved(std::move(v_full));
+        assert(Obj::num_moved == old_moved);
+        assert(Obj::num_move_assigned == old_move_assigned);
+        assert(v.GetStats().allocations == 1);
+    }
+    {
+        // Growing the outer vector relocates the inner vectors, never their elements
+        Obj::ResetCounters();
+        Vector<Vector<Obj>, VectorStats> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(4);
+        }
+        assert(v.GetStats().elements_moved < SIZE * 2);
+        assert(v.GetStats().elements_copied == 0);
+        assert(Obj::num_copied == 0);
+        assert(Obj::num_moved == 0);
+        assert(Obj::num_default_constructed == static_cast<int>(SIZE * 4));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test17() {
+    const size_t SIZE = 1100;
+    Obj::ResetCounters();
+    {
+        PersistentVector<Obj> v;
+        std::vector<PersistentVector<Obj>> versions;
+        for (size_t i = 0; i < SIZE; ++i) {
+            versions.push_back(v);
+            v = v.PushBack(Obj(static_cast<int>(i)));
+        }
+        assert(v.Size() == SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(versions[i].Size() == i);
+            assert(v[i].id == static_cast<int>(i));
+        }
+        assert(versions[SIZE / 2][SIZE / 2 - 1].id == static_cast<int>(SIZE / 2 - 1));
+
+        // Only the chunk on the path to the changed element is copied
+        const int old_copy_count = Obj::num_copied;
+        const PersistentVector<Obj> changed = v.Set(SIZE / 2, Obj(-1));
+        assert(Obj::num_copied - old_copy_count <= 32);
+        assert(changed[SIZE / 2].id == -1);
+        assert(v[SIZE / 2].id == static_cast<int>(SIZE / 2));
+        assert(&changed[0] == &v[0]);
+
+        PersistentVector<Obj> popped = v;
+        for (size_t i = SIZE; i > 0; --i) {
+            assert(popped[i - 1].id == static_cast<int>(i - 1));
+            popped = popped.PopBack();
+            assert(popped.Size() == i - 1);
+        }
+        assert(v.Size() == SIZE && v[SIZE - 1].id == static_cast<int>(SIZE - 1));
+
+        int expected_id = 0;
+        for (const Obj& obj : v) {
+            assert(obj.id == expected_id++);
+        }
+        assert(expected_id == static_cast<int>(SIZE));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        PersistentVector<int> base;
+        for (size_t i = 0; i < SIZE; ++i) {
+            base = base.PushBack(static_cast<int>(i));
+        }
+        auto transient = base.AsTransient();
+        for (size_t i = 0; i < SIZE; ++i) {
+            transient.Set(i, -static_cast<int>(i));
+        }
+        const int& first = transient.EmplaceBack(1);
+        transient.Set(SIZE, first + 1);
+        const PersistentVector<int> snapshot = transient.Persistent();
+        transient.PopBack();
+        transient.PopBack();
+        const PersistentVector<int> result = std::move(transient).Persistent();
+
+        assert(base.Size() == SIZE && base[SIZE - 1] == static_cast<int>(SIZE - 1));
+        assert(snapshot.Size() == SIZE + 1 && snapshot[SIZE] == 2 && snapshot[SIZE - 1] == 1 - static_cast<int>(SIZE));
+        assert(result.Size() == SIZE - 1 && result[SIZE - 2] == 2 - static_cast<int>(SIZE));
+    }
+}
+
+void Test18() {
+    const size_t SIZE = 100;
+    Obj::ResetCounters();
+    {
+        CowVector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        const CowVector<Obj> copy(v);
+        CowVector<Obj> other;
+        other = copy;
+        assert(Obj::num_copied == 0);
+        assert(v.UseCount() == 3);
+        assert(&std::as_const(v)[0] == &copy[0]);
+
+        // The first mutation copies, later ones do not,
+        // and the detached copy has room to grow, so the PushBack() only moves the new element in
+        const int moved = Obj::num_moved;
+        v.PushBack(Obj(-1));
+        assert(Obj::num_copied == static_cast<int>(SIZE));
+        assert(Obj::num_moved == moved + 1 && v.Capacity() >= SIZE * 2);
+        assert(v.UseCount() == 1 && copy.UseCount() == 2);
+        v.PushBack(Obj(-2));
+        v[0].id = -3;
+        assert(Obj::num_copied == static_cast<int>(SIZE));
+        assert(v.Size() == SIZE + 2 && copy.Size() == SIZE);
+        assert(copy[0].id == 0 && v[0].id == -3);
+
+        // Iterators into the shared elements stay usable for the detaching call
+        auto it = other.Erase(other.cbegin() + 1);
+        assert(it->id == 2 && other.Size() == SIZE - 1);
+        other.Insert(other.cbegin() + 1, Obj(1));
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(other[i].id == copy[i].id);
+        }
+        assert(&other[0] != &copy[0]);
+        assert(copy.UseCount() == 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        CowVector<int> v;
+        assert(v.Size() == 0 && v.UseCount() == 0 && v.cbegin() == v.cend());
+        v.PopBack();
+        v.Resize(SIZE);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([v, t]() mutable {
+                CowVector<int> local(v);
+                local[0] = t;
+                assert(local[0] == t && std::as_const(v)[0] == 0);
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        assert(v.UseCount() == 1 && v[0] == 0);
+    }
+}
+
+void Test19() {
+    const size_t SIZE = 1000;
+    Vector<int> v(SIZE);
+    for (size_t i = 0; i < SIZE; ++i) {
+        v[i] = static_cast<int>(i);
+    }
+    {
+        VectorView<int> view(v);
+        assert(view.Size() == SIZE && view.Data() == &v[0] && view.IsContiguous());
+        VectorView<int> middle = view.Subview(100, 200);
+        assert(middle.Size() == 200 && middle[0] == 100 && &middle[199] == &v[299]);
+        middle[0] = -1;
+        assert(v[100] == -1);
+        v[100] = 100;
+
+        // Every third element of [100, 300): 100, 103, ..., 298
+        VectorView<const int> strided = middle.Subview(0, 67, 3);
+        assert(!strided.IsContiguous() && strided.Stride() == 3);
+        assert(strided[66] == 298);
+        VectorView<const int> nested = strided.Subview(1, 10, 2);
+        assert(nested.Stride() == 6 && nested[0] == 103 && nested[9] == 157);
+
+        int expected = 100;
+        for (const int value : strided) {
+            assert(value == expected);
+            expected += 3;
+        }
+        assert(strided.end() - strided.begin() == 67);
+        assert(std::is_sorted(strided.begin(), strided.end()));
+        assert(*std::lower_bound(strided.begin(), strided.end(), 200) == 202);
+    }
+    {
+        const Vector<int>& cv = v;
+        VectorView<const int> view(cv);
+        assert(Find(view, 500) - view.begin() == 500);
+        assert(Find(view.Subview(0, 500), 500) == view.Subview(0, 500).end());
+        assert(Contains(view.Subview(10, 20, 5), 105));
+        assert(!Contains(view.Subview(10, 20, 5), 106));
+        assert(Count(view.Subview(0, SIZE / 2, 2), 998) == 1);
+        assert(Count(view, 7) == 1);
+        assert(FindFirstNotEqual(view.Subview(7, 1), 7) - view.begin() == 1);
+        assert(MinMax(view.Subview(1, 333, 3)) == std::make_pair(1, 997));
+        assert(MinMax(view.Subview(10, 5)) == std::make_pair(10, 14));
+    }
+}
+
+void Test20() {
+    const int SIZE = 1000;
+    {
+        Vector<int> keys;
+        for (int i = SIZE; i > 0; --i) {
+            keys.PushBack(i % 100);
+            keys.PushBack(i * 2);
+        }
+        FlatSet<int> set(std::move(keys));
+        assert(set.Size() == 100 + SIZE - 49);
+        assert(std::is_sorted(set.begin(), set.end()) && std::adjacent_find(set.begin(), set.end()) == set.end());
+        assert(set.Contains(99) && set.Contains(SIZE * 2) && !set.Contains(101) && set.Count(2) == 1);
+        assert(*set.LowerBound(101) == 102 && *set.UpperBound(102) == 104);
+
+        assert(set.Insert(101).second && !set.Insert(101).second);
+        assert(set.Erase(101) == 1 && set.Erase(101) == 0);
+
+        Vector<int> batch;
+        for (int i = 0; i < SIZE; ++i) {
+            batch.PushBack(SIZE * 3 - i * 3);
+        }
+        set.InsertBatch(std::move(batch));
+        assert(set.Contains(3) && set.Contains(SIZE * 3) && set.Contains(6) && !set.Contains(SIZE * 3 + 1));
+        assert(std::is_sorted(set.begin(), set.end()) && std::adjacent_find(set.begin(), set.end()) == set.end());
+        const FlatSet<int, std::greater<int>> reversed = {1, 3, 2, 3};
+        assert(reversed.Size() == 3 && *reversed.begin() == 3 && reversed.Keys()[2] == 1);
+    }
+    Obj::ResetCounters();
+    {
+        FlatMap<int, std::string> map = {{3, "c"}, {1, "a"}, {2, "b"}, {1, "x"}};
+        assert(map.Size() == 3 && map.At(1) == "a" && map.begin()->first == 1);
+        map[4] = "d";
+        map[1] += "a";
+        assert(map.Size() == 4 && map.At(1) == "aa" && map.At(4) == "d");
+        assert(!map.Insert({2, "y"}).second && map.At(2) == "b");
+        assert(map.TryEmplace(0, 3, 'z').second && map.At(0) == "zzz");
+        try {
+            map.At(5);
+            assert(false && "Exception is expected");
+        } catch (const std::out_of_range&) {
+        }
+        const std::pair<int, std::string> batch[] = {{6, "f"}, {2, "y"}, {5, "e"}, {6, "g"}};
+        map.InsertBatch(std::begin(batch), std::end(batch));
+        assert(map.Size() == 7 && map.At(2) == "b" && map.At(5) == "e" && map.At(6) == "f");
+        assert(map.Erase(0) == 1 && map.Find(0) == map.end() && map.Find(3)->second == "c");
+
+        // Batches merge with one move per element and no copies
+        FlatMap<int, Obj> objects;
+        for (int round = 0; round < 2; ++round) {
+            Vector<std::pair<int, Obj>> entries;
+            entries.Reserve(SIZE);
+            for (int i = 0; i < SIZE; ++i) {
+                entries.EmplaceBack(i * 2 + round, Obj(i));
+            }
+            const int old_move_count = Obj::num_moved;
+            objects.InsertBatch(std::move(entries));
+            assert(Obj::num_moved - old_move_count == SIZE * (round + 1));
+        }
+        assert(Obj::num_copied == 0);
+        assert(objects.Size() == SIZE * 2 && objects.At(SIZE * 2 - 1).id == SIZE - 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test21() {
+    const int SIZE = 100;
+    Obj::ResetCounters();
+    {
+        RingBuffer<Obj> ring(5);
+        assert(ring.Capacity() == 8 && ring.Size() == 0);
+        // A sliding window: pops never shift, the elements wrap around the block
+        for (int i = 0; i < SIZE; ++i) {
+            ring.EmplaceBack(i);
+            if (ring.Size() > 6) {
+                ring.PopFront();
+            }
+            assert(ring.Back().id == i && ring.Front().id == std::max(0, i - 5));
+        }
+        assert(ring.Capacity() == 8 && ring.Size() == 6);
+        const auto [first, second] = std::as_const(ring).Spans();
+        assert(first.Size() + second.Size() == 6 && second.Size() > 0);
+        assert(first[0].id == SIZE - 6 && second[second.Size() - 1].id == SIZE - 1);
+
+        // Growth unwraps the elements into one run
+        for (int i = 0; i < 4; ++i) {
+            ring.PushFront(Obj(-i));
+        }
+        assert(ring.Size() == 10 && ring.Capacity() == 16);
+        int expected[] = {-3, -2, -1, 0, SIZE - 6, SIZE - 5, SIZE - 4, SIZE - 3, SIZE - 2, SIZE - 1};
+        size_t index = 0;
+        for (const Obj& obj : ring) {
+            assert(obj.id == expected[index++]);
+        }
+        ring.PopBack();
+        ring.PopFront(2);
+        assert(ring.Size() == 7 && ring.Front().id == -1 && ring.Back().id == SIZE - 2);
+
+        RingBuffer<Obj> copy(ring);
+        assert(copy.Size() == 7 && copy[0].id == -1 && copy[6].id == SIZE - 2);
+        RingBuffer<Obj> moved(std::move(copy));
+        assert(moved.Size() == 7 && copy.Size() == 0);
+        ring.PushBack(ring.Front());
+        assert(ring.Back().id == -1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        RingBuffer<int> ring(4, RingOverflow::Overwrite);
+        for (int i = 0; i < SIZE; ++i) {
+            ring.PushBack(i);
+        }
+        assert(ring.Size() == 4 && ring.Capacity() == 4 && ring.Front() == SIZE - 4 && ring.Back() == SIZE - 1);
+        ring.PushFront(-1);
+        assert(ring.Size() == 4 && ring.Front() == -1 && ring.Back() == SIZE - 2);
+
+        RingBuffer<int> empty_ring(0, RingOverflow::Overwrite);
+        empty_ring.PushFront(1);
+        empty_ring.PushFront(2);
+        assert(empty_ring.Size() == 1 && empty_ring.Front() == 2);
+    }
+    {
+        RingBuffer<std::string> ring;
+        for (int i = 0; i < SIZE; ++i) {
+            ring.PushFront(std::to_string(i));
+        }
+        assert(ring.Size() == SIZE && ring.Front() == std::to_string(SIZE - 1) && ring.Back() == "0");
+    }
+}
+
+void Test22() {
+    const int SIZE = 1000;
+    {
+        // Same order as the binary heap of std::priority_queue, for pushes and for a bulk build
+        std::priority_queue<int> expected;
+        PriorityQueue<int> queue;
+        Vector<int> values;
+        for (int i = 0; i < SIZE; ++i) {
+            const int value = (i * 7919) % SIZE;
+            expected.push(value);
+            queue.Push(value);
+            values.PushBack(value);
+        }
+        PriorityQueue<int, std::less<int>, 8> heapified(std::move(values));
+        assert(queue.Size() == SIZE && heapified.Size() == SIZE);
+        // The children of the root start a cache line, so every group of 4 or 8 ints lies in one line
+        assert(reinterpret_cast<uintptr_t>(&queue.Top() + 1) % 64 == 0);
+        assert(reinterpret_cast<uintptr_t>(&heapified.Top() + 1) % 64 == 0);
+        while (!expected.empty()) {
+            assert(queue.Top() == expected.top() && heapified.Top() == expected.top());
+            expected.pop();
+            queue.Pop();
+            heapified.Pop();
+        }
+        assert(queue.Size() == 0 && heapified.Size() == 0);
+    }
+    {
+        // Dijkstra-style use of a min-heap: lowering the distance of a queued vertex
+        AddressablePriorityQueue<std::pair<int, int>, std::greater<std::pair<int, int>>> queue;
+        Vector<AddressablePriorityQueue<std::pair<int, int>>::Handle> handles;
+        for (int vertex = 0; vertex < SIZE; ++vertex) {
+            handles.PushBack(queue.Push({SIZE + vertex, vertex}));
+        }
+        for (int vertex = SIZE - 1; vertex >= 0; vertex -= 2) {
+            queue.DecreaseKey(handles[vertex], {SIZE - vertex, vertex});
+        }
+        assert(queue.Get(handles[SIZE - 1]).first == 1 && queue.TopHandle() == handles[SIZE - 1]);
+        int last = 0;
+        for (int i = 0; i < SIZE; ++i) {
+            const auto [distance, vertex] = queue.Top();
+            assert(distance >= last && queue.Contains(handles[vertex]));
+            last = distance;
+            queue.Pop();
+            assert(!queue.Contains(handles[vertex]));
+        }
+
+        // Handles of popped elements are reused
+        const auto handle = queue.Push({1, 1});
+        assert(handle < static_cast<size_t>(SIZE) && queue.Contains(handle) && queue.Get(handle).second == 1);
+    }
+    {
+        PriorityQueue<std::string> queue;
+        for (int i = 0; i < SIZE; ++i) {
+            queue.Emplace(static_cast<size_t>(i % 10 + 1), static_cast<char>('a' + i % 26));
+        }
+        assert(queue.Top() == std::string(10, 'z'));
+        queue.Push(queue.Top() + "z");
+        assert(queue.Top() == std::string(11, 'z') && queue.Size() == SIZE + 1);
+    }
+}
+
+void Test23() {
+    const int SIZE = 1000;
+    Obj::ResetCounters();
+    {
+        // Prepending is amortized O(1): every element moves a bounded number of times
+        Devector<Obj> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceFront(i);
+        }
+        assert(v.Size() == SIZE && v.Front().id == SIZE - 1 && v.Back().id == 0);
+        assert(Obj::num_moved < SIZE * 2 && Obj::num_copied == 0);
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(SIZE + i);
+        }
+        for (int i = 0; i < SIZE * 2; ++i) {
+            assert(v[i].id == (i < SIZE ? SIZE - 1 - i : i));
+        }
+        assert(&v[SIZE * 2 - 1] - &v[0] == SIZE * 2 - 1);
+
+        // Edits shift the shorter side
+        const int old_move_assigned = Obj::num_move_assigned;
+        v.Emplace(v.cbegin() + 10, -1);
+        v.Erase(v.cbegin() + 11);
+        v.Insert(v.cend() - 10, Obj(-2));
+        v.Erase(v.cend() - 12);
+        assert(Obj::num_move_assigned - old_move_assigned <= 4 * 12);
+        assert(v.Size() == SIZE * 2 && v[10].id == -1 && v[SIZE * 2 - 11].id == -2);
+        assert(v[9].id == SIZE - 10 && v[11].id == SIZE - 12 && v[SIZE * 2 - 12].id == SIZE * 2 - 12);
+
+        v.PopFront();
+        v.PopBack();
+        assert(v.Front().id == SIZE - 2 && v.Back().id == SIZE * 2 - 2);
+        Devector<Obj> copy(v);
+        assert(copy.Size() == v.Size() && copy[0].id == v[0].id && copy.FrontCapacity() == 0);
+        copy.PushFront(copy.Back());
+        assert(copy.Front().id == SIZE * 2 - 2);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Devector<std::string> v;
+        v.ReserveFront(4);
+        v.ReserveBack(4);
+        assert(v.FrontCapacity() == 4 && v.BackCapacity() == 4);
+        for (int i = 0; i < 4; ++i) {
+            v.PushFront(std::to_string(i));
+            v.PushBack(std::to_string(i));
+        }
+        assert(v.Capacity() == 8 && v.Front() == "3" && v.Back() == "3");
+        for (int i = 0; i < 5; ++i) {
+            v.Erase(v.cbegin());
+        }
+        assert(v.Size() == 3 && v.FrontCapacity() == 5 && v.BackCapacity() == 0);
+        // With more than half of the block free a push re-centres the elements instead of growing
+        v.PushBack("x");
+        assert(v.Capacity() == 8 && v.FrontCapacity() == 2 && v[0] == "1" && v.Back() == "x");
+    }
+}
+
+void Test24() {
+    const int SIZE = 1000;
+    Obj::ResetCounters();
+    {
+        GapBuffer<Obj> buffer;
+        for (int i = 0; i < SIZE; ++i) {
+            buffer.Emplace(i);
+        }
+        assert(buffer.Size() == SIZE && buffer.Cursor() == SIZE);
+
+        // Edits at the cursor move nothing, only the jump to it moves the elements in between
+        const int old_moved = Obj::num_moved;
+        buffer.MoveCursor(SIZE / 2);
+        assert(Obj::num_moved - old_moved == SIZE / 2);
+        for (int i = 0; i < 10; ++i) {
+            buffer.Emplace(-1 - i);
+        }
+        buffer.EraseBefore(5);
+        buffer.EraseAfter(5);
+        assert(Obj::num_moved - old_moved == SIZE / 2 && Obj::num_copied == 0);
+        assert(buffer.Size() == SIZE && buffer.Cursor() == SIZE / 2 + 5);
+        assert(buffer[SIZE / 2 - 1].id == SIZE / 2 - 1 && buffer[SIZE / 2].id == -1 && buffer[SIZE / 2 + 4].id == -5);
+        assert(buffer[SIZE / 2 + 5].id == SIZE / 2 + 5 && buffer[SIZE - 1].id == SIZE - 1);
+
+        // The elements stay on their sides of the gap through growth
+        buffer.Insert(10, buffer[SIZE - 1]);
+        buffer.Insert(SIZE, Obj(-100));
+        assert(buffer.Size() == SIZE + 2 && buffer[10].id == SIZE - 1 && buffer[11].id == 10 && buffer[SIZE].id == -100);
+        const auto [before, after] = buffer.Spans();
+        assert(before.Size() == SIZE + 1 && after.Size() == 1 && after[0].id == SIZE - 1);
+
+        GapBuffer<Obj> copy(buffer);
+        assert(copy.Size() == buffer.Size() && copy.GapSize() == 0);
+        int expected = 0;
+        for (auto it = copy.cbegin(); it != copy.cend(); ++it) {
+            assert(it->id == buffer[expected++].id);
+        }
+        copy.Erase(0, SIZE);
+        assert(copy.Size() == 2 && copy[0].id == -100 && copy[1].id == SIZE - 1);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Inserting an element the cursor jumps over
+        GapBuffer<std::string> buffer;
+        for (int i = 0; i < 10; ++i) {
+            buffer.Insert(std::string(20, static_cast<char>('a' + i)));
+        }
+        buffer.Insert(0, buffer[5]);
+        buffer.Insert(9, std::move(buffer[4]));
+        assert(buffer.Size() == 12 && buffer.Cursor() == 10);
+        const std::string expected = "fabc?efghdij";
+        for (size_t i = 0; i < expected.size(); ++i) {
+            assert(i == 4 || buffer[i] == std::string(20, expected[i]));
+        }
+    }
+    {
+        // Edits wandering around the cursor, checked against std::vector
+        GapBuffer<std::string> buffer;
+        std::vector<std::string> expected;
+        for (int i = 0; i < SIZE * 10; ++i) {
+            const size_t shifted = buffer.Cursor() + (i * 7) % 9;
+            const size_t pos = std::min(shifted < 4 ? 0 : shifted - 4, expected.size());
+            if (i % 3 == 0 && pos < expected.size()) {
+                buffer.Erase(pos);
+                expected.erase(expected.begin() + pos);
+            }
+            else {
+                buffer.Insert(pos, std::to_string(i));
+                expected.insert(expected.begin() + pos, std::to_string(i));
+            }
+        }
+        assert(std::equal(buffer.begin(), buffer.end(), expected.begin(), expected.end()));
+    }
+}
+
+void Test25() {
+    const int SIZE = 10000;
+    Obj::ResetCounters();
+    {
+        TieredVector<Obj> v;
+        for (int i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(i * 2);
+        }
+        assert(v.Size() == SIZE && v.BlockSize() == 128 && v[SIZE - 1].id == (SIZE - 1) * 2);
+
+        // A middle edit touches one block and one element per later block, not the whole tail
+        const int old_moves = Obj::num_moved + Obj::num_move_assigned;
+        v.Emplace(v.cbegin() + SIZE / 2, SIZE + 1);
+        v.Erase(v.cbegin() + SIZE / 3);
+        assert(Obj::num_moved + Obj::num_move_assigned - old_moves < SIZE / 10 && Obj::num_copied == 0);
+        assert(v.Size() == SIZE && v[SIZE / 3 - 1].id == (SIZE / 3 - 1) * 2 && v[SIZE / 3].id == (SIZE / 3 + 1) * 2);
+        assert(v[SIZE / 2 - 1].id == SIZE + 1 && v[SIZE / 2].id == SIZE);
+
+        v.Insert(v.cbegin(), v[SIZE - 1]);
+        v.Erase(v.cend() - 1);
+        assert(v.Size() == SIZE && v[0].id == (SIZE - 1) * 2 && v[1].id == 0 && v[SIZE - 1].id == (SIZE - 2) * 2);
+
+        TieredVector<Obj> copy(v);
+        assert(copy.Size() == v.Size() && copy.BlockSize() == v.BlockSize());
+        assert(std::equal(copy.begin(), copy.end(), v.begin(), [](const Obj& lhs, const Obj& rhs) {
+            return lhs.id == rhs.id;
+        }));
+        copy.Resize(10);
+        assert(copy.Size() == 10 && copy[9].id == v[9].id);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Elements that can only be copied; a failing copy must leave every block but the last full
+        struct CopyOnly {
+            explicit CopyOnly(int id)
+                : obj(id) {
+            }
+            CopyOnly(const CopyOnly&) = default;
+            CopyOnly& operator=(const CopyOnly&) = default;
+            Obj obj;
+        };
+        const int COUNT = 1000;
+        TieredVector<CopyOnly> v;
+        for (int i = 0; i < COUNT; ++i) {
+            v.EmplaceBack(i);
+        }
+        const size_t block_end = v.BlockSize() * 20;
+        v[block_end - 1].obj.throw_on_copy = true;
+        v[block_end].obj.throw_on_copy = true;
+        try {
+            v.Insert(v.cbegin() + 5, CopyOnly(-1));
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        try {
+            v.Erase(v.cbegin() + 5);
+            assert(false && "Exception is expected");
+        } catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == COUNT && Obj::GetAliveObjectCount() == COUNT);
+        for (int i = 0; i < COUNT; ++i) {
+            assert(v[i].obj.id == i);
+        }
+
+        v[block_end - 1].obj.throw_on_copy = false;
+        v[block_end].obj.throw_on_copy = false;
+        v.Insert(v.cbegin() + 5, CopyOnly(-1));
+        v.Erase(v.cbegin() + COUNT / 2);
+        assert(v.Size() == COUNT && v[5].obj.id == -1 && v[6].obj.id == 5 && v[COUNT / 2].obj.id == COUNT / 2);
+        assert(v[COUNT - 1].obj.id == COUNT - 1 && Obj::GetAliveObjectCount() == COUNT);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Out-of-order inserts checked against std::vector
+        TieredVector<int> v;
+        std::vector<int> expected;
+        for (int i = 0; i < SIZE; ++i) {
+            const size_t pos = (static_cast<size_t>(i) * 7919) % (expected.size() + 1);
+            if (i % 4 == 3) {
+                v.Erase(v.cbegin() + pos % expected.size());
+                expected.erase(expected.begin() + pos % expected.size());
+            }
+            else {
+                v.Insert(v.cbegin() + pos, i);
+                expected.insert(expected.begin() + pos, i);
+            }
+        }
+        assert(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+        std::sort(v.begin(), v.end());
+        std::sort(expected.begin(), expected.end());
+        assert(std::equal(v.cbegin(), v.cend(), expected.begin(), expected.end()));
+    }
+}
+
+void Test26() {
+    const int SIZE = 20000;
+    Obj::ResetCounters();
+    {
+        Rope<Obj> rope;
+        for (int i = 0; i < SIZE; ++i) {
+            rope.EmplaceBack(i);
+        }
+        assert(rope.Size() == SIZE && rope.Height() <= 6 && rope[SIZE - 1].id == SIZE - 1);
+
+        // A middle edit shifts elements within one chunk only
+        const int old_moves = Obj::num_moved + Obj::num_move_assigned;
+        rope.Emplace(rope.cbegin(), rope[SIZE / 2]);
+        rope.Insert(rope.begin(), Obj(-1));
+        auto it = rope.begin();
+        for (int i = 0; i < SIZE / 3; ++i) {
+            ++it;
+        }
+        rope.Erase(it);
+        assert(Obj::num_moved + Obj::num_move_assigned - old_moves < 200 && Obj::num_copied == 1);
+        assert(rope.Size() == SIZE + 1 && rope[0].id == -1 && rope[1].id == SIZE / 2 && rope[2].id == 0);
+        assert(rope[SIZE / 3 - 1].id == SIZE / 3 - 3 && rope[SIZE / 3].id == SIZE / 3 - 1);
+
+        Rope<Obj> copy(rope);
+        rope.PopBack();
+        assert(copy.Size() == SIZE + 1 && copy[SIZE].id == SIZE - 1 && rope.Size() == SIZE);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Elements that can only be copied; a failing copy, also while a full leaf splits, must not
+        // lose or leak elements
+        struct CopyOnly {
+            explicit CopyOnly(int id)
+                : obj(id) {
+            }
+            CopyOnly(const CopyOnly&) = default;
+            CopyOnly& operator=(const CopyOnly&) = default;
+            Obj obj;
+        };
+        const int COUNT = 1000;
+        Rope<CopyOnly> rope;
+        std::vector<int> expected;
+        for (int i = 0; i < COUNT; ++i) {
+            rope.EmplaceBack(i);
+            expected.push_back(i);
+        }
+        int throws = 0;
+        for (int i = 0; i < COUNT; ++i) {
+            // Copies do not inherit the flag, so it is set again on every round
+            for (CopyOnly& value : rope) {
+                value.obj.throw_on_copy = value.obj.id % 5 == 4;
+            }
+            const size_t pos = (static_cast<size_t>(i) * 7919) % (expected.size() + 1);
+            try {
+                rope.Emplace(Rope<CopyOnly>::const_iterator(&rope, pos), -1);
+                expected.insert(expected.begin() + pos, -1);
+            } catch (const std::runtime_error&) {
+                ++throws;
+            }
+        }
+        assert(throws > 0 && rope.Size() == expected.size());
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(expected.size()));
+        for (size_t i = 0; i < expected.size(); ++i) {
+            assert(rope[i].obj.id == expected[i]);
+        }
+        for (CopyOnly& value : rope) {
+            value.obj.throw_on_copy = false;
+        }
+        rope.Emplace(Rope<CopyOnly>::const_iterator(&rope, 1), -2);
+        assert(rope.Size() == expected.size() + 1 && rope[1].obj.id == -2 && rope[2].obj.id == expected[1]);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Edits all over the sequence checked against std::vector
+        Rope<int> rope;
+        std::vector<int> expected;
+        for (int i = 0; i < SIZE; ++i) {
+            const size_t pos = (static_cast<size_t>(i) * 7919) % (expected.size() + 1);
+            if (i % 3 == 2) {
+                rope.Erase(Rope<int>::const_iterator(&rope, pos % expected.size()));
+                expected.erase(expected.begin() + pos % expected.size());
+            }
+            else {
+                rope.Insert(Rope<int>::const_iterator(&rope, pos), i);
+                expected.insert(expected.begin() + pos, i);
+            }
+        }
+        assert(std::equal(rope.begin(), rope.end(), expected.begin(), expected.end()));
+
+        // Chunks cover the elements in order
+        size_t index = 0;
+        rope.ForEachChunk([&](VectorView<int> chunk) {
+            assert(chunk.Size() > 0 && chunk.IsContiguous());
+            for (int value : chunk) {
+                assert(value == expected[index++]);
+            }
+        });
+        assert(index == expected.size());
+
+        // Split and Concat keep the order for cuts at the ends, at chunk seams and inside chunks
+        for (size_t cut : {size_t(0), size_t(1), expected.size() / 3, expected.size() - 1, expected.size()}) {
+            Rope<int> right = rope.Split(cut);
+            assert(rope.Size() == cut && right.Size() == expected.size() - cut);
+            assert(std::equal(rope.cbegin(), rope.cend(), expected.begin(), expected.begin() + cut));
+            assert(std::equal(right.cbegin(), right.cend(), expected.begin() + cut, expected.end()));
+            rope.Concat(std::move(right));
+            assert(right.Size() == 0 && rope.Size() == expected.size());
+        }
+        assert(std::equal(rope.begin(), rope.end(), expected.begin(), expected.end()));
+
+        // Ropes of very different heights, built from many small pieces
+        Rope<int> pieces;
+        for (int i = 0; i < 100; ++i) {
+            Rope<int> piece = rope.Split(rope.Size() - std::min<size_t>(rope.Size(), 1 + i * 7));
+            piece.Concat(std::move(pieces));
+            pieces = std::move(piece);
+        }
+        rope.Concat(std::move(pieces));
+        assert(rope.Size() == expected.size());
+        auto back = rope.cend();
+        for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+            assert(*--back == *it);
+        }
+        assert(back == rope.cbegin());
+    }
+}
+
 struct C {
     C() noexcept {
         ++def_ctor;
@@ -642,6 +1865,26 @@ int main() {
         Test4();
         Test5();
         Test6();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
         Benchmark();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -0,0 +1,443 @@
+#pragma once
+#include "ring_buffer.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// A sequence with the interface of Vector made of RingBuffer blocks of one power-of-two capacity B.
+// Every block but the last one is full, so an index maps to a block and an offset in it with a shift
+// and a mask, and random access stays O(1). Emplace() and Erase() shift only the shorter side inside
+// the block of the position and then pass one element across each later block boundary, which is an
+// O(1) push and pop at the ends of the rings: O(B + n / B) instead of the O(n) of Vector.
+//
+// B doubles whenever there are more than 2B blocks, which keeps B around sqrt(n / 2) and both
+// operations O(sqrt n). Like Vector, the blocks are kept when the elements are removed. Elements that
+// may throw on a move are copied into new blocks from the block of the position on instead, which is
+// O(n) but leaves the vector unchanged if a copy throws.
+template <typename T>
+class TieredVector {
+public: // ------- Types -------
+
+    // A random access iterator over the elements.
+    template <bool IsConst>
+    class Iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using Container = std::conditional_t<IsConst, const TieredVector, TieredVector>;
+
+        Iterator() = default;
+        Iterator(Container* container, size_t index) noexcept
+            : container_(container)
+            , index_(index) {
+        }
+        // A const iterator from a mutable one.
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : container_(other.container_)
+            , index_(other.index_) {
+        }
+
+        reference operator*() const noexcept {
+            return (*container_)[index_];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+        reference operator[](difference_type n) const noexcept {
+            return *(*this + n);
+        }
+
+        Iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        Iterator operator++(int) noexcept {
+            Iterator old = *this;
+            ++index_;
+            return old;
+        }
+        Iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        Iterator operator--(int) noexcept {
+            Iterator old = *this;
+            --index_;
+            return old;
+        }
+        Iterator& operator+=(difference_type n) noexcept {
+            index_ += n;
+            return *this;
+        }
+        Iterator& operator-=(difference_type n) noexcept {
+            index_ -= n;
+            return *this;
+        }
+        friend Iterator operator+(Iterator it, difference_type n) noexcept {
+            return it += n;
+        }
+        friend Iterator operator+(difference_type n, Iterator it) noexcept {
+            return it += n;
+        }
+        friend Iterator operator-(Iterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        bool operator==(const Iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const Iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+        bool operator<(const Iterator& other) const noexcept {
+            return index_ < other.index_;
+        }
+        bool operator>(const Iterator& other) const noexcept {
+            return index_ > other.index_;
+        }
+        bool operator<=(const Iterator& other) const noexcept {
+            return index_ <= other.index_;
+        }
+        bool operator>=(const Iterator& other) const noexcept {
+            return index_ >= other.index_;
+        }
+
+    private:
+        template <bool>
+        friend class Iterator;
+
+        Container* container_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+public: // ------- Constructors -------
+
+    TieredVector() = default;
+
+    explicit TieredVector(size_t size) {
+        Resize(size);
+    }
+
+    TieredVector(const TieredVector& other)
+        : shift_(other.shift_) {
+        Reserve(other.size_);
+        for (const T& value : other) {
+            EmplaceBack(value);
+        }
+    }
+
+    TieredVector(TieredVector&& other) noexcept {
+        this->Swap(other);
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Get size of the vector.
+    size_t Size() const noexcept {
+        return size_;
+    }
+    // Get capacity of the vector, the total capacity of its blocks.
+    size_t Capacity() const noexcept {
+        return blocks_.Size() << shift_;
+    }
+    // Get the capacity of one block.
+    size_t BlockSize() const noexcept {
+        return size_t(1) << shift_;
+    }
+
+    // Reserve memory for at least `new_capacity` elements, enlarging the blocks first if they are too
+    // small for that many elements.
+    void Reserve(size_t new_capacity) {
+        size_t shift = shift_;
+        while ((new_capacity >> shift) > (size_t(2) << shift)) {
+            ++shift;
+        }
+        if (shift != shift_) {
+            Rebuild(shift);
+        }
+        blocks_.Reserve((new_capacity + BlockSize() - 1) >> shift_);
+        while (Capacity() < new_capacity) {
+            blocks_.EmplaceBack(BlockSize());
+        }
+    }
+
+    // Removes the last element of the vector and decrements the size by 1.
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            blocks_[(size_ - 1) >> shift_].PopBack();
+            --size_;
+        }
+    }
+
+    // Changes the size of the vector to fit `new_size`.
+    void Resize(size_t new_size) {
+        Reserve(new_size);
+        while (size_ > new_size) {
+            PopBack();
+        }
+        while (size_ < new_size) {
+            EmplaceBack();
+        }
+    }
+
+    // Adds `value` to the back of the vector.
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    // Constructs an element at the back of the vector with `args` parameters.
+    // @returns a reference to the constructed element.
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            // Adding a block may move the elements `args` refer to
+            T value(std::forward<Args>(args)...);
+            AddBlock();
+            return EmplaceBackUnchecked(std::move(value));
+        }
+        return EmplaceBackUnchecked(std::forward<Args>(args)...);
+    }
+
+    // Construct an element at `pos` of the vector with `args` parameters in O(sqrt n).
+    // @returns an iterator to the constructed element.
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        assert(pos >= cbegin() && pos <= cend());
+        const size_t index = pos - cbegin();
+        if (index == size_) {
+            EmplaceBack(std::forward<Args>(args)...);
+            return begin() + index;
+        }
+        // The arguments may refer to elements that are about to be shifted
+        T value(std::forward<Args>(args)...);
+        if (size_ == Capacity()) {
+            AddBlock();
+        }
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            // Every block from the one of `index` on passes its last element to the front of the next one
+            const size_t block = index >> shift_;
+            for (size_t i = size_ >> shift_; i > block; --i) {
+                blocks_[i].PushFront(std::move(blocks_[i - 1].Back()));
+                blocks_[i - 1].PopBack();
+            }
+            InsertIntoBlock(blocks_[block], index & Mask(), std::move(value));
+        }
+        else {
+            CopyTail(index, &value);
+        }
+        ++size_;
+        return begin() + index;
+    }
+
+    // Inserts `value` at the `pos` position.
+    // @returns iterator to the inserted element
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    // Erases an element at `pos` in O(sqrt n) and returns the iterator to the new element at this position.
+    iterator Erase(const_iterator pos) {
+        assert(pos >= cbegin() && pos < cend());
+        const size_t index = pos - cbegin();
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            const size_t block = index >> shift_;
+            EraseFromBlock(blocks_[block], index & Mask());
+            // Every later block passes its first element to the back of the previous one
+            const size_t last = (size_ - 1) >> shift_;
+            for (size_t i = block + 1; i <= last; ++i) {
+                blocks_[i - 1].PushBack(std::move(blocks_[i].Front()));
+                blocks_[i].PopFront();
+            }
+        }
+        else {
+            CopyTail(index, nullptr);
+        }
+        --size_;
+        return begin() + index;
+    }
+
+    // Swaps the elements with `other` vector.
+    void Swap(TieredVector& other) noexcept {
+        blocks_.Swap(other.blocks_);
+        std::swap(shift_, other.shift_);
+        std::swap(size_, other.size_);
+    }
+
+public: // ------- Operators -------
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return blocks_[index >> shift_][index & Mask()];
+    }
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return blocks_[index >> shift_][index & Mask()];
+    }
+
+    TieredVector& operator=(const TieredVector& other) {
+        if (this != &other) {
+            TieredVector other_copy(other);
+            this->Swap(other_copy);
+        }
+        return *this;
+    }
+    TieredVector& operator=(TieredVector&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    // Blocks hold 2^MIN_SHIFT elements at least.
+    static constexpr size_t MIN_SHIFT = 4;
+
+    size_t Mask() const noexcept {
+        return BlockSize() - 1;
+    }
+
+    template <typename... Args>
+    T& EmplaceBackUnchecked(Args&&... args) {
+        T& element = blocks_[size_ >> shift_].EmplaceBack(std::forward<Args>(args)...);
+        ++size_;
+        return element;
+    }
+
+    // Adds an empty block at the back, doubling the block size first if there are 2B blocks already.
+    void AddBlock() {
+        if ((blocks_.Size() >> shift_) >= 2) {
+            Rebuild(shift_ + 1);
+            if (size_ < Capacity()) {
+                return;
+            }
+        }
+        blocks_.EmplaceBack(BlockSize());
+    }
+
+    // Moves the elements into blocks of 2^`new_shift` elements. All blocks are allocated before the
+    // first element is touched, and elements that may throw on a move are copied, so that a throw
+    // leaves the vector unchanged.
+    void Rebuild(size_t new_shift) {
+        const size_t block_size = size_t(1) << new_shift;
+        const size_t block_count = (size_ + block_size - 1) >> new_shift;
+        Vector<RingBuffer<T>> blocks;
+        blocks.Reserve(block_count);
+        for (size_t i = 0; i < block_count; ++i) {
+            blocks.EmplaceBack(block_size);
+        }
+        for (size_t i = 0; i < size_; ++i) {
+            blocks[i >> new_shift].EmplaceBack(std::move_if_noexcept((*this)[i]));
+        }
+        blocks_.Swap(blocks);
+        shift_ = new_shift;
+    }
+
+    // Copies the elements from the block of `index` on into new blocks, with `*inserted` at `index` if
+    // it is given and without the element at `index` otherwise, and swaps them in. Unlike passing
+    // elements across the blocks one by one, a throwing copy leaves the vector unchanged. `size_` is
+    // left to the caller.
+    void CopyTail(size_t index, const T* inserted) {
+        const size_t first = index >> shift_;
+        const size_t new_size = inserted ? size_ + 1 : size_ - 1;
+        const size_t end = ((std::max(size_, new_size) - 1) >> shift_) + 1;
+        Vector<RingBuffer<T>> tail;
+        tail.Reserve(end - first);
+        for (size_t i = first; i < end; ++i) {
+            tail.EmplaceBack(BlockSize());
+        }
+        for (size_t i = first << shift_; i < new_size; ++i) {
+            const size_t from = i < index ? i : inserted ? i - 1 : i + 1;
+            tail[(i >> shift_) - first].PushBack(i == index && inserted ? *inserted : (*this)[from]);
+        }
+        for (size_t i = first; i < end; ++i) {
+            blocks_[i].Swap(tail[i - first]);
+        }
+    }
+
+    // Inserts `value` at `offset` of a block that is not full, shifting the shorter side of it.
+    static void InsertIntoBlock(RingBuffer<T>& block, size_t offset, T&& value) {
+        const size_t size = block.Size();
+        if (offset == 0) {
+            block.PushFront(std::move(value));
+        }
+        else if (offset == size) {
+            block.PushBack(std::move(value));
+        }
+        else if (offset < size - offset) {
+            block.PushFront(std::move(block.Front()));
+            for (size_t i = 1; i < offset; ++i) {
+                block[i] = std::move(block[i + 1]);
+            }
+            block[offset] = std::move(value);
+        }
+        else {
+            block.PushBack(std::move(block.Back()));
+            for (size_t i = size - 1; i > offset; --i) {
+                block[i] = std::move(block[i - 1]);
+            }
+            block[offset] = std::move(value);
+        }
+    }
+
+    // Erases the element at `offset` of a block, shifting the shorter side of it.
+    static void EraseFromBlock(RingBuffer<T>& block, size_t offset) {
+        const size_t size = block.Size();
+        if (offset < size - offset - 1) {
+            for (size_t i = offset; i > 0; --i) {
+                block[i] = std::move(block[i - 1]);
+            }
+            block.PopFront();
+        }
+        else {
+            for (size_t i = offset; i + 1 < size; ++i) {
+                block[i] = std::move(block[i + 1]);
+            }
+            block.PopBack();
+        }
+    }
+
+private:
+    Vector<RingBuffer<T>> blocks_;
+    size_t shift_ = MIN_SHIFT;
+    size_t size_ = 0;
+};
@@ -1,174 +1,518 @@
 #pragma once
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <new>
 #include <utility>
 #include <memory>
+#include <thread>
+#include <exception>
+#include <system_error>
+#include <cerrno>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// With C++20 constexpr allocation RawMemory and Vector can be used in constant expressions,
+// e.g. to build a lookup table at compile time. Memory allocated during constant evaluation must be
+// freed before it ends, so results have to be copied out into a non-allocating type.
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L
+#define VECTOR_HAS_CONSTEXPR_ALLOC 1
+#define VECTOR_CONSTEXPR constexpr
+#else
+#define VECTOR_HAS_CONSTEXPR_ALLOC 0
+#define VECTOR_CONSTEXPR
+#endif
+
+namespace vector_detail {
+
+// Constructs a T at `p`; std::construct_at is the only way to do so during constant evaluation.
+template <typename T, typename... Args>
+VECTOR_CONSTEXPR T* ConstructAt(T* p, Args&&... args) {
+#if VECTOR_HAS_CONSTEXPR_ALLOC
+    return std::construct_at(p, std::forward<Args>(args)...);
+#else
+    return new (p) T(std::forward<Args>(args)...);
+#endif
+}
+
+// The std::uninitialized_* algorithms are not constexpr before C++26, so constant evaluation
+// goes through equivalent element-by-element loops.
+template <typename T>
+VECTOR_CONSTEXPR void UninitializedValueConstructN(T* first, size_t n) {
+#if VECTOR_HAS_CONSTEXPR_ALLOC
+    if (std::is_constant_evaluated()) {
+        size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                ConstructAt(first + i);
+            }
+        }
+        catch (...) {
+            std::destroy_n(first, i);
+            throw;
+        }
+        return;
+    }
+#endif
+    std::uninitialized_value_construct_n(first, n);
+}
 
-// A wrapper-class for working with raw memory.
+template <typename T>
+VECTOR_CONSTEXPR void UninitializedCopyN(const T* first, size_t n, T* result) {
+#if VECTOR_HAS_CONSTEXPR_ALLOC
+    if (std::is_constant_evaluated()) {
+        size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                ConstructAt(result + i, first[i]);
+            }
+        }
+        catch (...) {
+            std::destroy_n(result, i);
+            throw;
+        }
+        return;
+    }
+#endif
+    std::uninitialized_copy_n(first, n, result);
+}
+
+template <typename T>
+VECTOR_CONSTEXPR void UninitializedMoveN(T* first, size_t n, T* result) {
+#if VECTOR_HAS_CONSTEXPR_ALLOC
+    if (std::is_constant_evaluated()) {
+        size_t i = 0;
+        try {
+            for (; i < n; ++i) {
+                ConstructAt(result + i, std::move(first[i]));
+            }
+        }
+        catch (...) {
+            std::destroy_n(result, i);
+            throw;
+        }
+        return;
+    }
+#endif
+    std::uninitialized_move_n(first, n, result);
+}
+
+} // namespace vector_detail
+
+// Where the pages of a RawMemory block are placed on a NUMA machine.
+enum class MemoryPlacement {
+    Default,    // Plain `operator new`, the kernel's default policy applies
+    Bind,       // Pages are allocated only on the nodes in `node_mask`
+    Interleave, // Pages are spread round-robin across the nodes in `node_mask`
+    Local       // Pages are allocated on the node of the thread that first touches them
+};
+
+// Placement of a memory block: the kind of policy and the bitmask of NUMA nodes it refers to.
+// Non-default placements are mmap-backed and only honoured on Linux, elsewhere they fall back to `Default`.
+struct PlacementPolicy {
+    MemoryPlacement placement = MemoryPlacement::Default;
+    unsigned long node_mask = 0;
+};
+
+// A wrapper-class for working with raw memory: a pointer and a capacity. A block with a non-default
+// placement keeps its policy in a header at the start of its mapping, in front of the elements, and
+// marks `capacity_` with the PLACED bit, so the default path pays nothing for NUMA support.
 template <typename T>
 class RawMemory {
 public: // ------- Constructors / Destructor -------
-    RawMemory() = default;
+    VECTOR_CONSTEXPR RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
+    explicit VECTOR_CONSTEXPR RawMemory(size_t capacity)
         : buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
 
+    // A block with a non-default `policy` is mapped even for a zero `capacity`, to keep the policy.
+    VECTOR_CONSTEXPR RawMemory(size_t capacity, PlacementPolicy policy) {
+        if (policy.placement == MemoryPlacement::Default){
+            buffer_ = Allocate(capacity);
+            capacity_ = capacity;
+        }
+        else{
+            buffer_ = AllocatePlaced(capacity, policy, capacity_);
+        }
+    }
+
     RawMemory(const RawMemory& other) = delete;
-    RawMemory(RawMemory&& other){
+    VECTOR_CONSTEXPR RawMemory(RawMemory&& other){
         buffer_ = other.buffer_;
         capacity_ = other.capacity_;
-        
+
         other.capacity_ = 0;
         other.buffer_ = nullptr;
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    VECTOR_CONSTEXPR ~RawMemory() {
+        Deallocate(buffer_, capacity_);
     }
 
 public: // ------- Methods -------
 
     // Exchange the values with `other` RawMemory type.
-    void Swap(RawMemory& other) noexcept {
+    VECTOR_CONSTEXPR void Swap(RawMemory& other) noexcept {
         std::swap(buffer_, other.buffer_);
         std::swap(capacity_, other.capacity_);
     }
 
     // Return the pointer to the contained block of data.
-    const T* GetAddress() const noexcept {
+    VECTOR_CONSTEXPR const T* GetAddress() const noexcept {
         return buffer_;
     }
     // Return the pointer to the contained block of data.
-    T* GetAddress() noexcept {
+    VECTOR_CONSTEXPR T* GetAddress() noexcept {
         return buffer_;
     }
 
     // Return the capacity to store elements in the memory block.
-    size_t Capacity() const {
-        return capacity_;
+    VECTOR_CONSTEXPR size_t Capacity() const {
+        return capacity_ & ~PLACED;
     }
 
+    // Return the placement policy the memory block was allocated with.
+    VECTOR_CONSTEXPR PlacementPolicy Placement() const noexcept {
+        if ((capacity_ & PLACED) == 0){
+            return PlacementPolicy();
+        }
+        return HeaderOf(buffer_)->policy;
+    }
+
+    // Return the bitmask of NUMA nodes the already faulted-in pages of the block currently reside on.
+    // Pages that were never touched are not counted; returns 0 if the query is not supported.
+    unsigned long ResidentNodes() const noexcept {
+        unsigned long nodes = 0;
+#ifdef __linux__
+        if (Capacity() == 0){
+            return nodes;
+        }
+        const uintptr_t page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        const uintptr_t first_page = reinterpret_cast<uintptr_t>(buffer_) & ~(page_size - 1);
+        const uintptr_t last = reinterpret_cast<uintptr_t>(buffer_ + Capacity());
+        const size_t BATCH = 512;
+        void* pages[BATCH];
+        int status[BATCH];
+        for (uintptr_t page = first_page; page < last;){
+            size_t count = 0;
+            for (; count < BATCH && page < last; ++count, page += page_size){
+                pages[count] = reinterpret_cast<void*>(page);
+            }
+            // With a null node list move_pages() only reports where each page is
+            if (syscall(SYS_move_pages, 0, count, pages, nullptr, status, 0) != 0){
+                return 0;
+            }
+            for (size_t i = 0; i < count; ++i){
+                if (status[i] >= 0 && status[i] < static_cast<int>(sizeof(nodes) * 8)){
+                    nodes |= 1ul << status[i];
+                }
+            }
+        }
+#endif
+        return nodes;
+    }
 
 public: // ------- Operators -------
 
     RawMemory& operator=(const RawMemory& other) = delete;
-    RawMemory& operator=(RawMemory&& other){
+    VECTOR_CONSTEXPR RawMemory& operator=(RawMemory&& other){
         if (this != &other){
-            Deallocate(buffer_);
+            Deallocate(buffer_, capacity_);
+            buffer_ = nullptr;
             capacity_ = 0;
             Swap(other);
         }
         return *this;
     }
 
-    T* operator+(size_t offset) noexcept {
-        assert(offset <= capacity_);
+    VECTOR_CONSTEXPR T* operator+(size_t offset) noexcept {
+        assert(offset <= Capacity());
         return buffer_ + offset;
     }
 
-    const T* operator+(size_t offset) const noexcept {
+    VECTOR_CONSTEXPR const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this) + offset;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
-        assert(index < capacity_);
+    VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
+        assert(index < Capacity());
         return buffer_[index];
     }
 
 private:
-    // Allocate raw memory for `n` elements and return the pointer to this memory.
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    // The bit of `capacity_` marking a mapped block with a PlacedHeader; no block holds 2^63 elements.
+    static constexpr size_t PLACED = size_t{1} << (sizeof(size_t) * 8 - 1);
+
+    // What a mapped block needs to be unmapped and re-created, kept in front of its elements.
+    struct PlacedHeader {
+        PlacementPolicy policy;
+        size_t mapped_bytes = 0;
+    };
+    // The elements start this far into the mapping: one cache line, or more for over-aligned types.
+    static constexpr size_t HEADER_BYTES = alignof(T) > 64 ? alignof(T) : 64;
+    static_assert(sizeof(PlacedHeader) <= HEADER_BYTES);
+
+    static PlacedHeader* HeaderOf(T* buf) noexcept {
+        return reinterpret_cast<PlacedHeader*>(reinterpret_cast<char*>(buf) - HEADER_BYTES);
+    }
+
+    // Allocate raw memory for `n` elements and return the pointer to this memory, aligned for `T` even
+    // if it is over-aligned. Constant evaluation can only allocate through std::allocator.
+    static VECTOR_CONSTEXPR T* Allocate(size_t n) {
+#if VECTOR_HAS_CONSTEXPR_ALLOC
+        if (std::is_constant_evaluated()){
+            return n != 0 ? std::allocator<T>().allocate(n) : nullptr;
+        }
+#endif
+        if (n == 0){
+            return nullptr;
+        }
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__){
+            return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t(alignof(T))));
+        }
+        else {
+            return static_cast<T*>(operator new(n * sizeof(T)));
+        }
+    }
+
+    // Map raw memory for `n` elements behind a PlacedHeader with the NUMA `policy` applied and store `n`
+    // marked as PLACED in `capacity`. Falls back to `Allocate()` where NUMA policies are not available.
+    static T* AllocatePlaced(size_t n, PlacementPolicy policy, size_t& capacity) {
+#ifdef __linux__
+        const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t bytes = (HEADER_BYTES + n * sizeof(T) + page_size - 1) / page_size * page_size;
+        void* buf = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (buf == MAP_FAILED){
+            throw std::bad_alloc();
+        }
+
+        int mode = MPOL_LOCAL;
+        const unsigned long* mask = nullptr;
+        unsigned long max_node = 0;
+        if (policy.placement != MemoryPlacement::Local){
+            mode = policy.placement == MemoryPlacement::Bind ? MPOL_BIND : MPOL_INTERLEAVE;
+            mask = &policy.node_mask;
+            max_node = sizeof(policy.node_mask) * 8 + 1;
+        }
+        if (syscall(SYS_mbind, buf, bytes, mode, mask, max_node, 0) != 0){
+            const int error = errno;
+            munmap(buf, bytes);
+            throw std::system_error(error, std::generic_category(), "mbind");
+        }
+        new (buf) PlacedHeader{policy, bytes};
+        capacity = n | PLACED;
+        return reinterpret_cast<T*>(static_cast<char*>(buf) + HEADER_BYTES);
+#else
+        (void)policy;
+        capacity = n;
+        return Allocate(n);
+#endif
     }
 
-    // Deallocate raw memory in `buf` buffer previosly allocated.
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    // Deallocate raw memory in `buf` buffer previosly allocated with `capacity` as stored in `capacity_`,
+    // which has the PLACED bit set for mapped buffers.
+    static VECTOR_CONSTEXPR void Deallocate(T* buf, size_t capacity) noexcept {
+#if VECTOR_HAS_CONSTEXPR_ALLOC
+        if (std::is_constant_evaluated()){
+            if (buf != nullptr){
+                std::allocator<T>().deallocate(buf, capacity);
+            }
+            return;
+        }
+#endif
+#ifdef __linux__
+        if ((capacity & PLACED) != 0){
+            PlacedHeader* header = HeaderOf(buf);
+            munmap(header, header->mapped_bytes);
+            return;
+        }
+#endif
+        (void)capacity;
+        if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__){
+            operator delete(buf, std::align_val_t(alignof(T)));
+        }
+        else {
+            operator delete(buf);
+        }
     }
 
     T* buffer_ = nullptr;
+    // The number of elements, with the PLACED bit set if the block is mapped behind a PlacedHeader.
     size_t capacity_ = 0;
 };
 
-template <typename T>
+// Tag for selecting the overloads that value-construct elements on several threads at once.
+// Every page of a large buffer is then first touched by one of the worker threads, so page
+// faults are spread across cores instead of being taken serially by the calling thread.
+// Value-construction of the element type must be safe to run concurrently.
+struct ParallelConstruct {
+    size_t num_threads = std::thread::hardware_concurrency();
+};
+
+// Stats policy that records nothing: every hook is empty and the member takes no space in Vector.
+struct NoStats {
+    VECTOR_CONSTEXPR void OnAllocate(size_t /*capacity*/, size_t /*bytes*/) noexcept {
+    }
+    VECTOR_CONSTEXPR void OnDeallocate() noexcept {
+    }
+    VECTOR_CONSTEXPR void OnGrow() noexcept {
+    }
+    VECTOR_CONSTEXPR void OnRelocate(size_t /*moved*/, size_t /*copied*/) noexcept {
+    }
+};
+
+// Stats policy counting the buffer traffic of one vector object: the buffers it allocated and freed
+// (buffers exchanged by Swap or moves are counted by the object that frees them), reallocations,
+// and the elements moved or copied into a new buffer on reallocation.
+struct VectorStats {
+    VECTOR_CONSTEXPR void OnAllocate(size_t capacity, size_t bytes) noexcept {
+        ++allocations;
+        bytes_allocated += bytes;
+        peak_capacity = std::max(peak_capacity, capacity);
+    }
+    VECTOR_CONSTEXPR void OnDeallocate() noexcept {
+        ++deallocations;
+    }
+    VECTOR_CONSTEXPR void OnGrow() noexcept {
+        ++growths;
+    }
+    VECTOR_CONSTEXPR void OnRelocate(size_t moved, size_t copied) noexcept {
+        elements_moved += moved;
+        elements_copied += copied;
+    }
+
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t bytes_allocated = 0;
+    size_t growths = 0;
+    size_t elements_moved = 0;
+    size_t elements_copied = 0;
+    size_t peak_capacity = 0;
+};
+
+// `Stats` receives a callback for every allocation, deallocation, reallocation and relocation of
+// elements; the default NoStats compiles all of them away.
+template <typename T, typename Stats = NoStats>
 class Vector {
 public: // ------- Constructors / Destructor -------
 
     using iterator = T*;
     using const_iterator = const T*;
 
-    Vector() = default;
-    explicit Vector(size_t size) : data_(RawMemory<T>(size)), size_(size) {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size);
+    VECTOR_CONSTEXPR Vector() = default;
+    explicit VECTOR_CONSTEXPR Vector(size_t size) : data_(RawMemory<T>(size)), size_(size) {
+        vector_detail::UninitializedValueConstructN(data_.GetAddress(), size);
+        __RecordAllocation();
+    }
+
+    // Constructs `size` elements using `policy.num_threads` threads.
+    Vector(size_t size, ParallelConstruct policy) : data_(RawMemory<T>(size)), size_(size) {
+        __ParallelValueConstruct(data_.GetAddress(), size, policy.num_threads);
+        __RecordAllocation();
+    }
+
+    // Creates an empty vector whose buffers, including those allocated on growth, are placed according to `placement`.
+    explicit Vector(PlacementPolicy placement) : data_(RawMemory<T>(0, placement)) {
     }
 
-    explicit Vector(const Vector& other) : data_(RawMemory<T>(other.Size())), size_(other.Size()) {
-        std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+    // Constructs `size` elements in a buffer placed according to `placement`.
+    Vector(size_t size, PlacementPolicy placement) : data_(RawMemory<T>(size, placement)), size_(size) {
+        vector_detail::UninitializedValueConstructN(data_.GetAddress(), size);
+        __RecordAllocation();
     }
 
-    explicit Vector(Vector&& other){
+    explicit VECTOR_CONSTEXPR Vector(const Vector& other) : data_(RawMemory<T>(other.Size(), other.data_.Placement())), size_(other.Size()) {
+        vector_detail::UninitializedCopyN(other.data_.GetAddress(), size_, data_.GetAddress());
+        __RecordAllocation();
+    }
+
+    explicit VECTOR_CONSTEXPR Vector(Vector&& other) noexcept{
         this->Swap(other);
     }
 
-    ~Vector(){
+    VECTOR_CONSTEXPR ~Vector(){
         std::destroy_n(data_.GetAddress(), size_);
+        if (data_.Capacity() != 0){
+            stats_.OnDeallocate();
+        }
     }
 
 public: // ------- Methods -------
 
-    iterator begin() noexcept{
+    VECTOR_CONSTEXPR iterator begin() noexcept{
         return data_.GetAddress();
     }
-    iterator end() noexcept{
+    VECTOR_CONSTEXPR iterator end() noexcept{
         return data_.GetAddress() + size_;
     }
 
-    const_iterator begin() const noexcept{
+    VECTOR_CONSTEXPR const_iterator begin() const noexcept{
         return const_iterator(data_.GetAddress());
     }
-    const_iterator end() const noexcept{
+    VECTOR_CONSTEXPR const_iterator end() const noexcept{
         return const_iterator(data_.GetAddress() + size_);
     }
-    const_iterator cbegin() const noexcept{
+    VECTOR_CONSTEXPR const_iterator cbegin() const noexcept{
         return const_iterator(data_.GetAddress());
     }
-    const_iterator cend() const noexcept{
+    VECTOR_CONSTEXPR const_iterator cend() const noexcept{
         return const_iterator(data_.GetAddress() + size_);
     }
 
     // Get size of the vector.
-    size_t Size() const noexcept {
+    VECTOR_CONSTEXPR size_t Size() const noexcept {
         return size_;
     }
     // Get capacity of the vector.
-    size_t Capacity() const noexcept {
+    VECTOR_CONSTEXPR size_t Capacity() const noexcept {
         return data_.Capacity();
     }
 
+    // Get the statistics recorded by the `Stats` policy.
+    VECTOR_CONSTEXPR const Stats& GetStats() const noexcept {
+        return stats_;
+    }
+
+    // Get the placement policy of the vector's buffer.
+    PlacementPolicy Placement() const noexcept {
+        return data_.Placement();
+    }
+    // Get the bitmask of NUMA nodes the vector's pages currently reside on.
+    unsigned long ResidentNodes() const noexcept {
+        return data_.ResidentNodes();
+    }
+
     // Reserve a specified amount of memory for the vector element type.
-    void Reserve(size_t new_capacity){
+    VECTOR_CONSTEXPR void Reserve(size_t new_capacity){
         if (new_capacity <= data_.Capacity()){
             return;
         }
 
-        RawMemory<T> new_data(new_capacity);
+        RawMemory<T> new_data(new_capacity, data_.Placement());
 
         __CopyMoveConstruct(data_.GetAddress(), new_data.GetAddress(), size_);
 
         std::destroy_n(data_.GetAddress(), size_);
 
-        data_.Swap(new_data);
+        __ReplaceBuffer(new_data);
     }
 
     // Removes the last element of the vector and decremenets the size by 1.
-    void PopBack() noexcept{
+    VECTOR_CONSTEXPR void PopBack() noexcept{
         if (size_ > 0){
             std::destroy_at(data_.GetAddress() + size_ - 1);
             --size_;
@@ -176,29 +520,41 @@ public: // ------- Methods -------
     }
 
     // Changes the size of the vector to fit new_size.
-    void Resize(size_t new_size){
+    VECTOR_CONSTEXPR void Resize(size_t new_size){
         Reserve(new_size); // Make sure that the capacity of the vector is sufficient
         if (this->size_ > new_size){
             std::destroy_n(data_.GetAddress() + new_size, this->size_ - new_size);
         }
         else if (this->size_ < new_size){
-            std::uninitialized_value_construct_n(data_.GetAddress() + this->size_, new_size - this->size_);
+            vector_detail::UninitializedValueConstructN(data_.GetAddress() + this->size_, new_size - this->size_);
+        }
+        this->size_ = new_size;
+    }
+
+    // Changes the size of the vector to fit new_size, constructing new elements using `policy.num_threads` threads.
+    void Resize(size_t new_size, ParallelConstruct policy){
+        Reserve(new_size);
+        if (this->size_ > new_size){
+            std::destroy_n(data_.GetAddress() + new_size, this->size_ - new_size);
+        }
+        else if (this->size_ < new_size){
+            __ParallelValueConstruct(data_.GetAddress() + this->size_, new_size - this->size_, policy.num_threads);
         }
         this->size_ = new_size;
     }
 
     // Adds `value` to the back of the vector.
-    void PushBack(const T& value){
+    VECTOR_CONSTEXPR void PushBack(const T& value){
         EmplaceBack(std::forward<const T&>(value));
     }
 
     // Adds `value` to the back of the vector.
-    void PushBack(T&& value){
+    VECTOR_CONSTEXPR void PushBack(T&& value){
         EmplaceBack(std::forward<T&&>(value));
     }
 
     // Swaps the data with `other` vector.
-    void Swap(Vector& other) noexcept{
+    VECTOR_CONSTEXPR void Swap(Vector& other) noexcept{
         std::swap(this->size_, other.size_);
         data_.Swap(other.data_);
     }
@@ -206,18 +562,18 @@ public: // ------- Methods -------
     // Constructs an element at the back of the the vector with `args` parameters.
     // @returns a reference to the constructed element.
     template<typename... Args>
-    T& EmplaceBack(Args&&... args){
+    VECTOR_CONSTEXPR T& EmplaceBack(Args&&... args){
         iterator p_empl_element = nullptr;
         if (size_ == Capacity()){
-            RawMemory<T> tmp_mem(size_ == 0 ? 1 : size_ * 2);
-            p_empl_element = new(tmp_mem + size_) T(std::forward<Args>(args)...);
+            RawMemory<T> tmp_mem(size_ == 0 ? 1 : size_ * 2, data_.Placement());
+            p_empl_element = vector_detail::ConstructAt(tmp_mem + size_, std::forward<Args>(args)...);
 
             __CopyMoveConstruct(data_.GetAddress(), tmp_mem.GetAddress(), size_);
             std::destroy_n(data_.GetAddress(), size_);
-            data_.Swap(tmp_mem);
+            __ReplaceBuffer(tmp_mem);
         }
         else{
-            p_empl_element = new(data_ + size_) T(std::forward<Args>(args)...);
+            p_empl_element = vector_detail::ConstructAt(data_ + size_, std::forward<Args>(args)...);
         }
         ++size_;
         return *p_empl_element;
@@ -226,44 +582,49 @@ public: // ------- Methods -------
     // Construct an element at `pos` of the vector with `args` parameters.
     // @returns a pointer to the constructed element.
     template<typename... Args>
-    iterator Emplace(const_iterator pos, Args && ...args) {
+    VECTOR_CONSTEXPR iterator Emplace(const_iterator pos, Args && ...args) {
         assert(pos >= begin() && pos <= end());
         iterator p_empl_elem = nullptr;
         size_t distance = pos - begin();
         if (size_ == Capacity()) {
-            RawMemory<T> tmp_data(size_ == 0 ? 1 : size_ * 2);
-            p_empl_elem = new (tmp_data + distance) T(std::forward<Args>(args)...);
+            RawMemory<T> tmp_data(size_ == 0 ? 1 : size_ * 2, data_.Placement());
+            p_empl_elem = vector_detail::ConstructAt(tmp_data + distance, std::forward<Args>(args)...);
 
             if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-                std::uninitialized_move_n(begin(), distance, tmp_data.GetAddress());
-                std::uninitialized_move_n(begin() + distance, size_ - distance, tmp_data.GetAddress() + distance + 1);
+                vector_detail::UninitializedMoveN(begin(), distance, tmp_data.GetAddress());
+                vector_detail::UninitializedMoveN(begin() + distance, size_ - distance, tmp_data.GetAddress() + distance + 1);
+                stats_.OnRelocate(size_, 0);
             }
             else {
                 try {
-                    std::uninitialized_copy_n(begin(), distance, tmp_data.GetAddress());
-                    std::uninitialized_copy_n(begin() + distance, size_ - distance, tmp_data.GetAddress() + distance + 1);
+                    vector_detail::UninitializedCopyN(begin(), distance, tmp_data.GetAddress());
+                    vector_detail::UninitializedCopyN(begin() + distance, size_ - distance, tmp_data.GetAddress() + distance + 1);
                 }
                 catch (...) {
                     std::destroy_n(tmp_data.GetAddress() + distance, 1);
                     throw;
                 }
+                stats_.OnRelocate(0, size_);
             }
             std::destroy_n(begin(), size_);
-            data_.Swap(tmp_data);
+            __ReplaceBuffer(tmp_data);
+        }
+        else if (distance == size_) {
+            p_empl_elem = vector_detail::ConstructAt(data_ + size_, std::forward<Args>(args)...);
         }
         else {
-            if (size_ != 0) {
-                new (data_ + size_) T(std::move(*(end() - 1)));
-                try {
-                    std::move_backward(begin() + distance, end(), end() + 1);
-                }
-                catch (...) {
-                    std::destroy_n(end(), 1);
-                    throw;
-                }
-                std::destroy_at(begin() + distance);
+            // The arguments may refer to elements that are about to be shifted
+            T value(std::forward<Args>(args)...);
+            vector_detail::ConstructAt(data_ + size_, std::move(*(end() - 1)));
+            try {
+                std::move_backward(begin() + distance, end() - 1, end());
+                data_[distance] = std::move(value);
             }
-            p_empl_elem = new (data_ + distance) T(std::forward<Args>(args)...);
+            catch (...) {
+                std::destroy_n(end(), 1);
+                throw;
+            }
+            p_empl_elem = begin() + distance;
         }
         ++size_;
         return p_empl_elem;
@@ -271,15 +632,15 @@ public: // ------- Methods -------
 
     // Inserts `value` at the `pos` position.
     // @returns iterator to the inserted element
-    iterator Insert(const_iterator pos, const T& value){
+    VECTOR_CONSTEXPR iterator Insert(const_iterator pos, const T& value){
         return Emplace(pos, std::forward<const T&>(value));
     }
-    iterator Insert(const_iterator pos, T&& value){
+    VECTOR_CONSTEXPR iterator Insert(const_iterator pos, T&& value){
         return Emplace(pos, std::forward<T&&>(value));
     }
 
     // Erases an element at `pos` and returns the iterator to the new element at this position.
-    iterator Erase(const_iterator pos){
+    VECTOR_CONSTEXPR iterator Erase(const_iterator pos){
         assert(pos >= cbegin() && pos <= cend());
         size_t distance = pos - cbegin();
         std::move(begin() + distance + 1, end(), begin() + distance);
@@ -289,21 +650,24 @@ public: // ------- Methods -------
 
 public: // ------- Operators -------
     // Get a value of the element under the specified `index`. 
-    const T& operator[](size_t index) const noexcept {
+    VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
         assert(index < size_);
         return data_[index];
     }
 
-    Vector& operator=(const Vector& other){
+    VECTOR_CONSTEXPR Vector& operator=(const Vector& other){
         size_t other_size = other.Size();
         if (this != &other){
             if (other_size > this->Capacity()){ 
-                Vector other_copy(other);
-                this->Swap(other_copy);
+                RawMemory<T> new_data(other_size, data_.Placement());
+                vector_detail::UninitializedCopyN(other.data_.GetAddress(), other_size, new_data.GetAddress());
+                std::destroy_n(this->data_.GetAddress(), this->size_);
+                __ReplaceBuffer(new_data);
+                this->size_ = other_size;
             }
             else{
                 if (other_size < this->size_){
@@ -312,7 +676,7 @@ public: // ------- Operators -------
                 }
                 else{
                     std::copy(other.data_.GetAddress(), other.data_.GetAddress() + this->size_, this->data_.GetAddress());
-                    std::uninitialized_copy_n(other.data_.GetAddress() + this->size_, other_size - this->size_, this->data_.GetAddress() + this->size_);
+                    vector_detail::UninitializedCopyN(other.data_.GetAddress() + this->size_, other_size - this->size_, this->data_.GetAddress() + this->size_);
                 }
                 this->size_ = other_size;
             }
@@ -321,7 +685,7 @@ public: // ------- Operators -------
         return *this;
 
     }
-    Vector& operator=(Vector&& other){
+    VECTOR_CONSTEXPR Vector& operator=(Vector&& other) noexcept{
         if (this != &other){
             this->Swap(other);
         }
@@ -330,16 +694,479 @@ public: // ------- Operators -------
 private:
 
     // Copies or Moves (depending on type properties) `n` number of element from `first` memory block to `result` block
-    static void __CopyMoveConstruct(T* first, T* result, const size_t n){
+    VECTOR_CONSTEXPR void __CopyMoveConstruct(T* first, T* result, const size_t n){
         if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>){
-            std::uninitialized_move_n(first, n, result);
+            vector_detail::UninitializedMoveN(first, n, result);
+            stats_.OnRelocate(n, 0);
         }
         else{
-            std::uninitialized_copy_n(first, n, result);
+            vector_detail::UninitializedCopyN(first, n, result);
+            stats_.OnRelocate(0, n);
+        }
+    }
+
+    // Records the allocation of the buffer a constructor has just filled.
+    VECTOR_CONSTEXPR void __RecordAllocation() noexcept {
+        if (data_.Capacity() != 0){
+            stats_.OnAllocate(data_.Capacity(), data_.Capacity() * sizeof(T));
+        }
+    }
+
+    // Installs the already filled `new_data` as the vector's buffer after a reallocation;
+    // the old buffer is left in `new_data` and freed with it.
+    VECTOR_CONSTEXPR void __ReplaceBuffer(RawMemory<T>& new_data) noexcept {
+        data_.Swap(new_data);
+        stats_.OnGrow();
+        stats_.OnAllocate(data_.Capacity(), data_.Capacity() * sizeof(T));
+        if (new_data.Capacity() != 0){
+            stats_.OnDeallocate();
+        }
+    }
+
+    // Value-constructs `n` elements starting at `first`, splitting the range into chunks across `num_threads` threads.
+    // If any chunk throws, every successfully constructed chunk is destroyed and the first exception is rethrown.
+    static void __ParallelValueConstruct(T* first, const size_t n, size_t num_threads){
+        const size_t min_chunk = PARALLEL_MIN_BYTES_PER_THREAD / sizeof(T) + 1;
+        num_threads = std::min(std::max<size_t>(num_threads, 1), n / min_chunk + 1);
+        if (num_threads == 1){
+            std::uninitialized_value_construct_n(first, n);
+            return;
+        }
+
+        const size_t chunk = (n + num_threads - 1) / num_threads;
+        std::unique_ptr<std::exception_ptr[]> errors(new std::exception_ptr[num_threads]);
+        std::unique_ptr<std::thread[]> workers(new std::thread[num_threads - 1]);
+
+        auto construct_chunk = [&](size_t i){
+            const size_t from = std::min(i * chunk, n);
+            try {
+                std::uninitialized_value_construct_n(first + from, std::min(chunk, n - from));
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+        // Destroys the successfully constructed chunks among [begin_chunk, end_chunk).
+        auto destroy_chunks = [&](size_t begin_chunk, size_t end_chunk){
+            for (size_t i = begin_chunk; i < end_chunk; ++i){
+                const size_t from = std::min(i * chunk, n);
+                if (!errors[i]){
+                    std::destroy_n(first + from, std::min(chunk, n - from));
+                }
+            }
+        };
+        size_t started = 1;
+        try {
+            for (; started < num_threads; ++started){
+                workers[started - 1] = std::thread(construct_chunk, started);
+            }
+        }
+        catch (...) {
+            // Spawning failed: the running workers must be joined before `workers` is destroyed
+            for (size_t i = 0; i + 1 < started; ++i){
+                workers[i].join();
+            }
+            destroy_chunks(1, started);
+            throw;
+        }
+        construct_chunk(0); // The calling thread takes the first chunk itself
+        for (size_t i = 0; i + 1 < num_threads; ++i){
+            workers[i].join();
+        }
+
+        std::exception_ptr first_error = nullptr;
+        for (size_t i = 0; i < num_threads && !first_error; ++i){
+            first_error = errors[i];
+        }
+        if (first_error){
+            destroy_chunks(0, num_threads);
+            std::rethrow_exception(first_error);
         }
     }
 
+    // Parallel construction is not worth spawning a thread for less than this amount of memory.
+    static constexpr size_t PARALLEL_MIN_BYTES_PER_THREAD = 1 << 20;
+
 private:
     RawMemory<T> data_;
     size_t size_ = 0;
-};
\ No newline at end of file
+    [[no_unique_address]] Stats stats_;
+};
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_X86_POPCNT 1
+#else
+#define VECTOR_X86_POPCNT 0
+#endif
+
+namespace vector_detail {
+
+inline size_t PopcountWordsScalar(const uint64_t* words, size_t n) noexcept {
+    size_t count = 0;
+    for (size_t w = 0; w < n; ++w) {
+        count += static_cast<size_t>(__builtin_popcountll(words[w]));
+    }
+    return count;
+}
+
+#if VECTOR_X86_POPCNT
+// The same loop compiled for the POPCNT instruction; the baseline x86 build turns
+// __builtin_popcountll into a libgcc call per word.
+__attribute__((target("popcnt"))) inline size_t PopcountWordsPopcnt(const uint64_t* words, size_t n) noexcept {
+    size_t count = 0;
+    for (size_t w = 0; w < n; ++w) {
+        count += static_cast<size_t>(__builtin_popcountll(words[w]));
+    }
+    return count;
+}
+#endif
+
+// Get the number of set bits in `n` words, with the POPCNT kernel if the running CPU supports it.
+inline size_t PopcountWords(const uint64_t* words, size_t n) noexcept {
+#if VECTOR_X86_POPCNT
+    static const bool has_popcnt = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("popcnt") != 0;
+    }();
+    if (has_popcnt) {
+        return PopcountWordsPopcnt(words, n);
+    }
+#endif
+    return PopcountWordsScalar(words, n);
+}
+
+} // namespace vector_detail
+
+// A packed specialization storing one bit per element in 64-bit words.
+// Elements are accessed through proxy references; the bits past Size() in the last word are always zero,
+// which lets the bulk operations below work on whole words.
+template <>
+class Vector<bool> {
+public: // ------- Types -------
+
+    // A proxy referring to a single bit of the vector.
+    class reference {
+    public:
+        reference(uint64_t* word, uint64_t mask) noexcept : word_(word), mask_(mask) {
+        }
+
+        operator bool() const noexcept {
+            return (*word_ & mask_) != 0;
+        }
+
+        reference& operator=(bool value) noexcept {
+            *word_ = value ? (*word_ | mask_) : (*word_ & ~mask_);
+            return *this;
+        }
+        reference& operator=(const reference& other) noexcept {
+            return *this = static_cast<bool>(other);
+        }
+
+        // Inverts the referred bit.
+        void Flip() noexcept {
+            *word_ ^= mask_;
+        }
+
+    private:
+        uint64_t* word_;
+        uint64_t mask_;
+    };
+
+    // A random-access iterator over the bits of the vector, dereferencing to `reference` or `bool`.
+    template <bool IsConst>
+    class BitIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using words_pointer = std::conditional_t<IsConst, const uint64_t*, uint64_t*>;
+        using reference = std::conditional_t<IsConst, bool, Vector<bool>::reference>;
+
+        BitIterator() = default;
+        BitIterator(words_pointer words, size_t index) noexcept : words_(words), index_(index) {
+        }
+        // Allows converting an iterator to a const_iterator.
+        template <bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BitIterator(const BitIterator<OtherConst>& other) noexcept : words_(other.words_), index_(other.index_) {
+        }
+
+        reference operator*() const noexcept {
+            if constexpr (IsConst) {
+                return (words_[index_ / WORD_BITS] >> (index_ % WORD_BITS)) & 1;
+            }
+            else {
+                return reference(words_ + index_ / WORD_BITS, uint64_t{1} << (index_ % WORD_BITS));
+            }
+        }
+        reference operator[](difference_type offset) const noexcept {
+            return *(*this + offset);
+        }
+
+        BitIterator& operator++() noexcept { ++index_; return *this; }
+        BitIterator& operator--() noexcept { --index_; return *this; }
+        BitIterator operator++(int) noexcept { BitIterator old = *this; ++index_; return old; }
+        BitIterator operator--(int) noexcept { BitIterator old = *this; --index_; return old; }
+        BitIterator& operator+=(difference_type offset) noexcept { index_ += offset; return *this; }
+        BitIterator& operator-=(difference_type offset) noexcept { index_ -= offset; return *this; }
+        BitIterator operator+(difference_type offset) const noexcept { return BitIterator(words_, index_ + offset); }
+        BitIterator operator-(difference_type offset) const noexcept { return BitIterator(words_, index_ - offset); }
+        difference_type operator-(const BitIterator& other) const noexcept {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+
+        bool operator==(const BitIterator& other) const noexcept { return index_ == other.index_; }
+        bool operator!=(const BitIterator& other) const noexcept { return index_ != other.index_; }
+        bool operator<(const BitIterator& other) const noexcept { return index_ < other.index_; }
+        bool operator<=(const BitIterator& other) const noexcept { return index_ <= other.index_; }
+        bool operator>(const BitIterator& other) const noexcept { return index_ > other.index_; }
+        bool operator>=(const BitIterator& other) const noexcept { return index_ >= other.index_; }
+
+        // Get the position of the iterator in the vector.
+        size_t Index() const noexcept {
+            return index_;
+        }
+
+    private:
+        template <bool>
+        friend class BitIterator;
+
+        words_pointer words_ = nullptr;
+        size_t index_ = 0;
+    };
+
+    using iterator = BitIterator<false>;
+    using const_iterator = BitIterator<true>;
+
+    static constexpr size_t WORD_BITS = 64;
+
+public: // ------- Constructors / Destructor -------
+
+    Vector() = default;
+    explicit Vector(size_t size, bool value = false) : words_(RawMemory<uint64_t>(WordsFor(size))), size_(size) {
+        std::fill_n(words_.GetAddress(), WordsFor(size), value ? ~uint64_t{0} : uint64_t{0});
+        ClearTail();
+    }
+
+    explicit Vector(const Vector& other) : words_(RawMemory<uint64_t>(WordsFor(other.size_))), size_(other.size_) {
+        std::copy_n(other.words_.GetAddress(), WordsFor(size_), words_.GetAddress());
+    }
+
+    explicit Vector(Vector&& other) noexcept {
+        this->Swap(other);
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() noexcept {
+        return iterator(words_.GetAddress(), 0);
+    }
+    iterator end() noexcept {
+        return iterator(words_.GetAddress(), size_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(words_.GetAddress(), 0);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(words_.GetAddress(), size_);
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // Get size of the vector in bits.
+    size_t Size() const noexcept {
+        return size_;
+    }
+    // Get capacity of the vector in bits.
+    size_t Capacity() const noexcept {
+        return words_.Capacity() * WORD_BITS;
+    }
+
+    // Return the pointer to the packed words, bit `i` is bit `i % 64` of word `i / 64`.
+    const uint64_t* Words() const noexcept {
+        return words_.GetAddress();
+    }
+    // Get the number of words holding the vector's bits.
+    size_t WordCount() const noexcept {
+        return WordsFor(size_);
+    }
+
+    // Reserve memory for at least `new_capacity` bits.
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        RawMemory<uint64_t> new_words(WordsFor(new_capacity));
+        std::copy_n(words_.GetAddress(), WordsFor(size_), new_words.GetAddress());
+        words_.Swap(new_words);
+    }
+
+    // Changes the size of the vector to fit `new_size`, new bits are set to `value`.
+    void Resize(size_t new_size, bool value = false) {
+        Reserve(new_size);
+        if (new_size > size_) {
+            const size_t old_size = size_;
+            const size_t first_new_word = WordsFor(old_size);
+            if (old_size % WORD_BITS != 0 && value) {
+                words_[old_size / WORD_BITS] |= ~uint64_t{0} << (old_size % WORD_BITS);
+            }
+            std::fill(words_ + first_new_word, words_ + WordsFor(new_size), value ? ~uint64_t{0} : uint64_t{0});
+        }
+        size_ = new_size;
+        ClearTail();
+    }
+
+    // Adds `value` to the back of the vector.
+    void PushBack(bool value) {
+        if (size_ == Capacity()) {
+            Reserve(size_ == 0 ? WORD_BITS : size_ * 2);
+        }
+        if (size_ % WORD_BITS == 0) {
+            words_[size_ / WORD_BITS] = 0;
+        }
+        ++size_;
+        (*this)[size_ - 1] = value;
+    }
+
+    // Adds `value` to the back of the vector.
+    // @returns a proxy reference to the added bit.
+    reference EmplaceBack(bool value) {
+        PushBack(value);
+        return (*this)[size_ - 1];
+    }
+
+    // Removes the last bit of the vector.
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            --size_;
+            ClearTail();
+        }
+    }
+
+    // Swaps the data with `other` vector.
+    void Swap(Vector& other) noexcept {
+        std::swap(size_, other.size_);
+        words_.Swap(other.words_);
+    }
+
+    // Erases the bit at `pos`, shifting the following bits down one word at a time.
+    // @returns the iterator to the new bit at this position.
+    iterator Erase(const_iterator pos) {
+        const size_t index = pos.Index();
+        assert(index < size_);
+        const size_t word_count = WordsFor(size_);
+        uint64_t* words = words_.GetAddress();
+        size_t w = index / WORD_BITS;
+        const uint64_t low_mask = (uint64_t{1} << (index % WORD_BITS)) - 1;
+        words[w] = (words[w] & low_mask) | ((words[w] >> 1) & ~low_mask);
+        for (; w + 1 < word_count; ++w) {
+            words[w] |= words[w + 1] << (WORD_BITS - 1);
+            words[w + 1] >>= 1;
+        }
+        --size_;
+        ClearTail();
+        return begin() + static_cast<std::ptrdiff_t>(index);
+    }
+
+    // Get the number of set bits.
+    size_t Count() const noexcept {
+        return vector_detail::PopcountWords(words_.GetAddress(), WordsFor(size_));
+    }
+
+    // Get the index of the first set bit, or Size() if no bit is set.
+    size_t FindFirstSet() const noexcept {
+        const uint64_t* words = words_.GetAddress();
+        for (size_t w = 0, word_count = WordsFor(size_); w < word_count; ++w) {
+            if (words[w] != 0) {
+                return w * WORD_BITS + static_cast<size_t>(__builtin_ctzll(words[w]));
+            }
+        }
+        return size_;
+    }
+
+    // In-place bitwise operations with an `other` vector of the same size.
+    // The word loops carry no dependencies, so the compiler turns them into SIMD code.
+    Vector& And(const Vector& other) noexcept {
+        return ApplyWords(other, [](uint64_t a, uint64_t b) { return a & b; });
+    }
+    Vector& Or(const Vector& other) noexcept {
+        return ApplyWords(other, [](uint64_t a, uint64_t b) { return a | b; });
+    }
+    Vector& Xor(const Vector& other) noexcept {
+        return ApplyWords(other, [](uint64_t a, uint64_t b) { return a ^ b; });
+    }
+
+    // Inverts every bit of the vector.
+    Vector& Not() noexcept {
+        uint64_t* words = words_.GetAddress();
+        for (size_t w = 0, word_count = WordsFor(size_); w < word_count; ++w) {
+            words[w] = ~words[w];
+        }
+        ClearTail();
+        return *this;
+    }
+
+public: // ------- Operators -------
+
+    bool operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return (words_[index / WORD_BITS] >> (index % WORD_BITS)) & 1;
+    }
+
+    reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return reference(words_ + index / WORD_BITS, uint64_t{1} << (index % WORD_BITS));
+    }
+
+    Vector& operator=(const Vector& other) {
+        if (this != &other) {
+            if (other.size_ > Capacity()) {
+                Vector other_copy(other);
+                this->Swap(other_copy);
+            }
+            else {
+                std::copy_n(other.words_.GetAddress(), WordsFor(other.size_), words_.GetAddress());
+                size_ = other.size_;
+            }
+        }
+        return *this;
+    }
+    Vector& operator=(Vector&& other) noexcept {
+        if (this != &other) {
+            this->Swap(other);
+        }
+        return *this;
+    }
+
+private:
+    // Get the number of words needed to store `bits` bits.
+    static size_t WordsFor(size_t bits) noexcept {
+        return (bits + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    // Zeroes the unused bits of the last word.
+    void ClearTail() noexcept {
+        if (size_ % WORD_BITS != 0) {
+            words_[size_ / WORD_BITS] &= (uint64_t{1} << (size_ % WORD_BITS)) - 1;
+        }
+    }
+
+    template <typename Op>
+    Vector& ApplyWords(const Vector& other, Op op) noexcept {
+        assert(size_ == other.size_);
+        uint64_t* words = words_.GetAddress();
+        const uint64_t* other_words = other.words_.GetAddress();
+        for (size_t w = 0, word_count = WordsFor(size_); w < word_count; ++w) {
+            words[w] = op(words[w], other_words[w]);
+        }
+        return *this;
+    }
+
+private:
+    RawMemory<uint64_t> words_;
+    size_t size_ = 0;
+};
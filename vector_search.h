@@ -0,0 +1,334 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+// Search kernels for contiguous ranges and vectors: Find, Count, Contains, FindFirstNotEqual, MinMax.
+// For integral and floating-point element types they run SSE2/AVX2/AVX-512 loops picked at runtime
+// from the CPU's features, every other element type goes through plain scalar loops.
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_SEARCH_X86_SIMD 1
+#else
+#define VECTOR_SEARCH_X86_SIMD 0
+#endif
+
+// The widest instruction set the search kernels may use.
+enum class SimdLevel {
+    Scalar,
+    Sse2,
+    Avx2,
+    Avx512
+};
+
+// Detect the SimdLevel supported by the running CPU, the result is computed once and cached.
+inline SimdLevel DetectSimdLevel() noexcept {
+#if VECTOR_SEARCH_X86_SIMD
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+            return SimdLevel::Avx512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::Avx2;
+        }
+        if (__builtin_cpu_supports("sse2")) {
+            return SimdLevel::Sse2;
+        }
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+namespace vector_search_detail {
+
+// Element types the SIMD kernels handle: arithmetic types that fit a vector lane.
+template <typename T>
+inline constexpr bool IS_SIMD_ELEMENT_V = std::is_arithmetic_v<T> && !std::is_same_v<T, bool>
+    && !std::is_same_v<T, long double>;
+
+// Keeps the searched value out of template argument deduction, so `Find(v, 5)` works for any `Vector<T>`.
+template <typename T>
+struct NonDeduced {
+    using type = T;
+};
+template <typename T>
+using NonDeducedT = typename NonDeduced<T>::type;
+
+// ------- Scalar kernels -------
+
+// Return the index of the first element equal (or not equal, if `equal` is false) to `value`, or `n`.
+template <typename T>
+size_t ScalarFind(const T* data, size_t n, const T& value, bool equal) {
+    for (size_t i = 0; i < n; ++i) {
+        if ((data[i] == value) == equal) {
+            return i;
+        }
+    }
+    return n;
+}
+
+template <typename T>
+size_t ScalarCount(const T* data, size_t n, const T& value) {
+    size_t count = 0;
+    for (size_t i = 0; i < n; ++i) {
+        count += data[i] == value ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename T>
+std::pair<T, T> ScalarMinMax(const T* data, size_t n) {
+    std::pair<T, T> result(data[0], data[0]);
+    for (size_t i = 1; i < n; ++i) {
+        if (data[i] < result.first) {
+            result.first = data[i];
+        }
+        if (result.second < data[i]) {
+            result.second = data[i];
+        }
+    }
+    return result;
+}
+
+#if VECTOR_SEARCH_X86_SIMD
+
+// ------- Generic SIMD kernels -------
+// Written with GCC vector extensions and always inlined, so each one is compiled for the
+// instruction set of the target-specific wrapper it is called from.
+
+#define VECTOR_SEARCH_INLINE inline __attribute__((always_inline))
+
+template <typename T, size_t Bytes>
+struct Lanes {
+    typedef T type __attribute__((vector_size(Bytes)));
+};
+
+// Bitwise OR of all lanes of a comparison mask: non-zero if any lane compared true.
+template <size_t Bytes, typename Mask>
+VECTOR_SEARCH_INLINE uint64_t AnyLane(const Mask& mask) {
+    uint64_t words[Bytes / 8];
+    std::memcpy(words, &mask, Bytes);
+    uint64_t any = 0;
+    for (size_t i = 0; i < Bytes / 8; ++i) {
+        any |= words[i];
+    }
+    return any;
+}
+
+// Number of lanes of a comparison mask that compared true.
+template <size_t Bytes, typename T, typename Mask>
+VECTOR_SEARCH_INLINE size_t CountLanes(const Mask& mask) {
+    uint64_t words[Bytes / 8];
+    std::memcpy(words, &mask, Bytes);
+    size_t bits = 0;
+    for (size_t i = 0; i < Bytes / 8; ++i) {
+        bits += static_cast<size_t>(__builtin_popcountll(words[i]));
+    }
+    return bits / (sizeof(T) * 8);
+}
+
+template <size_t Bytes, typename T>
+VECTOR_SEARCH_INLINE size_t FindKernel(const T* data, size_t n, T value, bool equal) {
+    using V = typename Lanes<T, Bytes>::type;
+    constexpr size_t LANES = Bytes / sizeof(T);
+    const V needle = V{} + value;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        V chunk;
+        std::memcpy(&chunk, data + i, Bytes);
+        // The scalar tail below pinpoints the matching lane inside the chunk
+        if (equal ? AnyLane<Bytes>(chunk == needle) : AnyLane<Bytes>(chunk != needle)) {
+            break;
+        }
+    }
+    return i + ScalarFind(data + i, n - i, value, equal);
+}
+
+template <size_t Bytes, typename T>
+VECTOR_SEARCH_INLINE size_t CountKernel(const T* data, size_t n, T value) {
+    using V = typename Lanes<T, Bytes>::type;
+    constexpr size_t LANES = Bytes / sizeof(T);
+    const V needle = V{} + value;
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + LANES <= n; i += LANES) {
+        V chunk;
+        std::memcpy(&chunk, data + i, Bytes);
+        count += CountLanes<Bytes, T>(chunk == needle);
+    }
+    return count + ScalarCount(data + i, n - i, value);
+}
+
+template <size_t Bytes, typename T>
+VECTOR_SEARCH_INLINE std::pair<T, T> MinMaxKernel(const T* data, size_t n) {
+    using V = typename Lanes<T, Bytes>::type;
+    constexpr size_t LANES = Bytes / sizeof(T);
+    if (n < LANES) {
+        return ScalarMinMax(data, n);
+    }
+    V lo;
+    std::memcpy(&lo, data, Bytes);
+    V hi = lo;
+    size_t i = LANES;
+    for (; i + LANES <= n; i += LANES) {
+        V chunk;
+        std::memcpy(&chunk, data + i, Bytes);
+        lo = chunk < lo ? chunk : lo;
+        hi = hi < chunk ? chunk : hi;
+    }
+    T lanes_lo[LANES];
+    T lanes_hi[LANES];
+    std::memcpy(lanes_lo, &lo, Bytes);
+    std::memcpy(lanes_hi, &hi, Bytes);
+    std::pair<T, T> result(ScalarMinMax(lanes_lo, LANES).first, ScalarMinMax(lanes_hi, LANES).second);
+    if (i < n) {
+        const std::pair<T, T> tail = ScalarMinMax(data + i, n - i);
+        result.first = tail.first < result.first ? tail.first : result.first;
+        result.second = result.second < tail.second ? tail.second : result.second;
+    }
+    return result;
+}
+
+// ------- Target-specific entry points -------
+
+#define VECTOR_SEARCH_DEFINE_TARGET(SUFFIX, TARGET, BYTES)                                    \
+    template <typename T>                                                                     \
+    __attribute__((target(TARGET))) size_t Find##SUFFIX(const T* data, size_t n, T value,     \
+                                                        bool equal) {                         \
+        return FindKernel<BYTES>(data, n, value, equal);                                      \
+    }                                                                                         \
+    template <typename T>                                                                     \
+    __attribute__((target(TARGET))) size_t Count##SUFFIX(const T* data, size_t n, T value) {  \
+        return CountKernel<BYTES>(data, n, value);                                            \
+    }                                                                                         \
+    template <typename T>                                                                     \
+    __attribute__((target(TARGET))) std::pair<T, T> MinMax##SUFFIX(const T* data, size_t n) { \
+        return MinMaxKernel<BYTES>(data, n);                                                  \
+    }
+
+VECTOR_SEARCH_DEFINE_TARGET(Sse2, "sse2", 16)
+VECTOR_SEARCH_DEFINE_TARGET(Avx2, "avx2", 32)
+VECTOR_SEARCH_DEFINE_TARGET(Avx512, "avx512f,avx512bw", 64)
+
+#undef VECTOR_SEARCH_DEFINE_TARGET
+#undef VECTOR_SEARCH_INLINE
+
+#endif // VECTOR_SEARCH_X86_SIMD
+
+// ------- Dispatch -------
+
+template <typename T>
+size_t DispatchFind(const T* data, size_t n, const T& value, bool equal) {
+#if VECTOR_SEARCH_X86_SIMD
+    if constexpr (IS_SIMD_ELEMENT_V<T>) {
+        switch (DetectSimdLevel()) {
+        case SimdLevel::Avx512: return FindAvx512(data, n, value, equal);
+        case SimdLevel::Avx2: return FindAvx2(data, n, value, equal);
+        case SimdLevel::Sse2: return FindSse2(data, n, value, equal);
+        case SimdLevel::Scalar: break;
+        }
+    }
+#endif
+    return ScalarFind(data, n, value, equal);
+}
+
+template <typename T>
+size_t DispatchCount(const T* data, size_t n, const T& value) {
+#if VECTOR_SEARCH_X86_SIMD
+    if constexpr (IS_SIMD_ELEMENT_V<T>) {
+        switch (DetectSimdLevel()) {
+        case SimdLevel::Avx512: return CountAvx512(data, n, value);
+        case SimdLevel::Avx2: return CountAvx2(data, n, value);
+        case SimdLevel::Sse2: return CountSse2(data, n, value);
+        case SimdLevel::Scalar: break;
+        }
+    }
+#endif
+    return ScalarCount(data, n, value);
+}
+
+template <typename T>
+std::pair<T, T> DispatchMinMax(const T* data, size_t n) {
+#if VECTOR_SEARCH_X86_SIMD
+    if constexpr (IS_SIMD_ELEMENT_V<T>) {
+        switch (DetectSimdLevel()) {
+        case SimdLevel::Avx512: return MinMaxAvx512(data, n);
+        case SimdLevel::Avx2: return MinMaxAvx2(data, n);
+        case SimdLevel::Sse2: return MinMaxSse2(data, n);
+        case SimdLevel::Scalar: break;
+        }
+    }
+#endif
+    return ScalarMinMax(data, n);
+}
+
+} // namespace vector_search_detail
+
+// ------- Range interface -------
+
+// Returns a pointer to the first element in [`first`, `last`) equal to `value`, or `last`.
+template <typename T>
+const T* Find(const T* first, const T* last, const vector_search_detail::NonDeducedT<T>& value) {
+    return first + vector_search_detail::DispatchFind(first, static_cast<size_t>(last - first), value, true);
+}
+
+// Returns a pointer to the first element in [`first`, `last`) not equal to `value`, or `last`.
+template <typename T>
+const T* FindFirstNotEqual(const T* first, const T* last, const vector_search_detail::NonDeducedT<T>& value) {
+    return first + vector_search_detail::DispatchFind(first, static_cast<size_t>(last - first), value, false);
+}
+
+// Returns the number of elements in [`first`, `last`) equal to `value`.
+template <typename T>
+size_t Count(const T* first, const T* last, const vector_search_detail::NonDeducedT<T>& value) {
+    return vector_search_detail::DispatchCount(first, static_cast<size_t>(last - first), value);
+}
+
+// Checks whether [`first`, `last`) contains `value`.
+template <typename T>
+bool Contains(const T* first, const T* last, const vector_search_detail::NonDeducedT<T>& value) {
+    return Find(first, last, value) != last;
+}
+
+// Returns the smallest and the largest element of the non-empty range [`first`, `last`).
+// For floating-point ranges containing NaN the result is unspecified.
+template <typename T>
+std::pair<T, T> MinMax(const T* first, const T* last) {
+    assert(first < last);
+    return vector_search_detail::DispatchMinMax(first, static_cast<size_t>(last - first));
+}
+
+// ------- Vector interface -------
+
+template <typename T, typename Stats>
+typename Vector<T, Stats>::const_iterator Find(const Vector<T, Stats>& v, const vector_search_detail::NonDeducedT<T>& value) {
+    return Find(v.begin(), v.end(), value);
+}
+
+template <typename T, typename Stats>
+typename Vector<T, Stats>::const_iterator FindFirstNotEqual(const Vector<T, Stats>& v, const vector_search_detail::NonDeducedT<T>& value) {
+    return FindFirstNotEqual(v.begin(), v.end(), value);
+}
+
+template <typename T, typename Stats>
+size_t Count(const Vector<T, Stats>& v, const vector_search_detail::NonDeducedT<T>& value) {
+    return Count(v.begin(), v.end(), value);
+}
+
+template <typename T, typename Stats>
+bool Contains(const Vector<T, Stats>& v, const vector_search_detail::NonDeducedT<T>& value) {
+    return Contains(v.begin(), v.end(), value);
+}
+
+template <typename T, typename Stats>
+std::pair<T, T> MinMax(const Vector<T, Stats>& v) {
+    return MinMax(v.begin(), v.end());
+}
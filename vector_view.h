@@ -0,0 +1,255 @@
+#pragma once
+#include "vector.h"
+#include "vector_search.h"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+// A non-owning view of `size` elements `stride` elements apart, starting at `data`.
+// Slicing a Vector through a view (Subview() with an offset, a count and a step) copies nothing;
+// the viewed elements must outlive the view and must not be reallocated while it is used.
+// `T` may be const for a read-only view; a VectorView<T> converts to a VectorView<const T>.
+template <typename T>
+class VectorView {
+public: // ------- Types -------
+
+    using value_type = std::remove_const_t<T>;
+
+    // A random access iterator over the viewed elements.
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+
+        reference operator*() const noexcept {
+            return data_[index_ * stride_];
+        }
+        pointer operator->() const noexcept {
+            return &**this;
+        }
+        reference operator[](difference_type n) const noexcept {
+            return *(*this + n);
+        }
+
+        iterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator old = *this;
+            ++index_;
+            return old;
+        }
+        iterator& operator--() noexcept {
+            --index_;
+            return *this;
+        }
+        iterator operator--(int) noexcept {
+            iterator old = *this;
+            --index_;
+            return old;
+        }
+        iterator& operator+=(difference_type n) noexcept {
+            index_ += n;
+            return *this;
+        }
+        iterator& operator-=(difference_type n) noexcept {
+            index_ -= n;
+            return *this;
+        }
+        friend iterator operator+(iterator it, difference_type n) noexcept {
+            return it += n;
+        }
+        friend iterator operator+(difference_type n, iterator it) noexcept {
+            return it += n;
+        }
+        friend iterator operator-(iterator it, difference_type n) noexcept {
+            return it -= n;
+        }
+        friend difference_type operator-(const iterator& lhs, const iterator& rhs) noexcept {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        bool operator==(const iterator& other) const noexcept {
+            return index_ == other.index_;
+        }
+        bool operator!=(const iterator& other) const noexcept {
+            return index_ != other.index_;
+        }
+        bool operator<(const iterator& other) const noexcept {
+            return index_ < other.index_;
+        }
+        bool operator>(const iterator& other) const noexcept {
+            return index_ > other.index_;
+        }
+        bool operator<=(const iterator& other) const noexcept {
+            return index_ <= other.index_;
+        }
+        bool operator>=(const iterator& other) const noexcept {
+            return index_ >= other.index_;
+        }
+
+    private:
+        friend class VectorView;
+
+        iterator(T* data, size_t stride, size_t index) noexcept
+            : data_(data)
+            , stride_(stride)
+            , index_(index) {
+        }
+
+        // The position is kept as an index, so that no pointer past the end of the viewed range is formed.
+        T* data_ = nullptr;
+        size_t stride_ = 1;
+        size_t index_ = 0;
+    };
+
+public: // ------- Constructors -------
+
+    VectorView() = default;
+
+    VectorView(T* data, size_t size, size_t stride = 1) noexcept
+        : data_(data)
+        , size_(size)
+        , stride_(stride) {
+        assert(stride > 0);
+    }
+
+    // View all elements of `v`.
+    template <typename Stats>
+    VectorView(Vector<value_type, Stats>& v) noexcept
+        : VectorView(v.begin(), v.Size()) {
+    }
+    template <typename Stats, typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+    VectorView(const Vector<value_type, Stats>& v) noexcept
+        : VectorView(v.begin(), v.Size()) {
+    }
+
+    // A read-only view of the same elements.
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+    VectorView(const VectorView<U>& other) noexcept
+        : VectorView(other.Data(), other.Size(), other.Stride()) {
+    }
+
+public: // ------- Methods -------
+
+    iterator begin() const noexcept {
+        return iterator(data_, stride_, 0);
+    }
+    iterator end() const noexcept {
+        return iterator(data_, stride_, size_);
+    }
+
+    // Return the pointer to the first element of the view.
+    T* Data() const noexcept {
+        return data_;
+    }
+    // Get the number of elements in the view.
+    size_t Size() const noexcept {
+        return size_;
+    }
+    // Get the distance between two consecutive elements of the view, in elements.
+    size_t Stride() const noexcept {
+        return stride_;
+    }
+    // Checks whether the elements are adjacent in memory, so pointer-based algorithms apply.
+    bool IsContiguous() const noexcept {
+        return stride_ == 1 || size_ <= 1;
+    }
+
+    // Get a view of `count` elements starting at `offset`, taking every `step`-th element.
+    VectorView Subview(size_t offset, size_t count, size_t step = 1) const noexcept {
+        assert(step > 0);
+        assert(count == 0 || offset + (count - 1) * step < size_);
+        return VectorView(data_ + offset * stride_, count, stride_ * step);
+    }
+
+public: // ------- Operators -------
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index * stride_];
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+    size_t stride_ = 1;
+};
+
+// ------- VectorView interface of the search algorithms -------
+// Contiguous views run the SIMD kernels of vector_search.h, strided views plain scalar loops.
+
+namespace vector_view_detail {
+
+// Return the index of the first element of `view` equal (or not equal, if `equal` is false) to `value`.
+template <typename T, typename U>
+size_t FindIndex(const VectorView<T>& view, const U& value, bool equal) {
+    if (view.IsContiguous()) {
+        const T* first = view.Data();
+        const T* found = equal ? Find(first, first + view.Size(), value) : FindFirstNotEqual(first, first + view.Size(), value);
+        return static_cast<size_t>(found - first);
+    }
+    for (size_t i = 0; i < view.Size(); ++i) {
+        if ((view[i] == value) == equal) {
+            return i;
+        }
+    }
+    return view.Size();
+}
+
+} // namespace vector_view_detail
+
+template <typename T>
+typename VectorView<T>::iterator Find(const VectorView<T>& view, const vector_search_detail::NonDeducedT<std::remove_const_t<T>>& value) {
+    return view.begin() + vector_view_detail::FindIndex(view, value, true);
+}
+
+template <typename T>
+typename VectorView<T>::iterator FindFirstNotEqual(const VectorView<T>& view, const vector_search_detail::NonDeducedT<std::remove_const_t<T>>& value) {
+    return view.begin() + vector_view_detail::FindIndex(view, value, false);
+}
+
+template <typename T>
+size_t Count(const VectorView<T>& view, const vector_search_detail::NonDeducedT<std::remove_const_t<T>>& value) {
+    if (view.IsContiguous()) {
+        return Count(static_cast<const T*>(view.Data()), view.Data() + view.Size(), value);
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < view.Size(); ++i) {
+        count += view[i] == value ? 1 : 0;
+    }
+    return count;
+}
+
+template <typename T>
+bool Contains(const VectorView<T>& view, const vector_search_detail::NonDeducedT<std::remove_const_t<T>>& value) {
+    return Find(view, value) != view.end();
+}
+
+// For floating-point views containing NaN the result is unspecified.
+template <typename T>
+std::pair<std::remove_const_t<T>, std::remove_const_t<T>> MinMax(const VectorView<T>& view) {
+    assert(view.Size() > 0);
+    if (view.IsContiguous()) {
+        return MinMax(static_cast<const T*>(view.Data()), view.Data() + view.Size());
+    }
+    std::pair<std::remove_const_t<T>, std::remove_const_t<T>> result(view[0], view[0]);
+    for (size_t i = 1; i < view.Size(); ++i) {
+        if (view[i] < result.first) {
+            result.first = view[i];
+        }
+        if (result.second < view[i]) {
+            result.second = view[i];
+        }
+    }
+    return result;
+}